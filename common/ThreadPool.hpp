@@ -0,0 +1,138 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CommsCommon
+{
+    /*!
+     * A fixed-size pool of worker threads for data-parallel loops.
+     * The calling thread participates as worker 0, so a pool of size 1
+     * has no extra threads and runs everything inline.
+     * The pool is meant to be owned by a single block:
+     * parallelFor() must not be called concurrently from multiple threads.
+     */
+    class ThreadPool
+    {
+    public:
+        //! The range function is called with (workerIndex, begin, end)
+        typedef std::function<void(const size_t, const size_t, const size_t)> RangeFcn;
+
+        //! Create a pool of numThreads total workers, 0 means one per hardware thread
+        explicit ThreadPool(const size_t numThreads = 1):
+            _generation(0),
+            _pending(0),
+            _count(0),
+            _task(nullptr),
+            _shutdown(false)
+        {
+            size_t n = numThreads;
+            if (n == 0) n = std::max<size_t>(1, std::thread::hardware_concurrency());
+            for (size_t i = 1; i < n; i++)
+            {
+                _threads.emplace_back(&ThreadPool::workerLoop, this, i);
+            }
+        }
+
+        ~ThreadPool(void)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _shutdown = true;
+            }
+            _workCond.notify_all();
+            for (auto &t : _threads) t.join();
+        }
+
+        //! The total number of workers including the calling thread
+        size_t size(void) const
+        {
+            return _threads.size()+1;
+        }
+
+        /*!
+         * Split [0, count) into contiguous ranges, one per worker,
+         * and block until every range was processed.
+         * The first exception thrown by a worker is rethrown here.
+         */
+        void parallelFor(const size_t count, const RangeFcn &fcn)
+        {
+            if (_threads.empty() or count < 2)
+            {
+                fcn(0, 0, count);
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _task = &fcn;
+                _count = count;
+                _pending = _threads.size();
+                _error = nullptr;
+                _generation++;
+            }
+            _workCond.notify_all();
+
+            std::exception_ptr error;
+            try {this->runRange(0, fcn, count);}
+            catch (...) {error = std::current_exception();}
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _doneCond.wait(lock, [this]{return _pending == 0;});
+            _task = nullptr;
+            if (not error) error = _error;
+            if (error) std::rethrow_exception(error);
+        }
+
+    private:
+        void runRange(const size_t index, const RangeFcn &fcn, const size_t count)
+        {
+            const size_t begin = (count*index)/this->size();
+            const size_t end = (count*(index+1))/this->size();
+            if (begin != end) fcn(index, begin, end);
+        }
+
+        void workerLoop(const size_t index)
+        {
+            size_t generation = 0;
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (true)
+            {
+                _workCond.wait(lock, [&]{return _shutdown or _generation != generation;});
+                if (_shutdown) return;
+                generation = _generation;
+                const RangeFcn &fcn = *_task;
+                const size_t count = _count;
+
+                lock.unlock();
+                std::exception_ptr error;
+                try {this->runRange(index, fcn, count);}
+                catch (...) {error = std::current_exception();}
+                lock.lock();
+
+                if (error and not _error) _error = error;
+                if (--_pending == 0) _doneCond.notify_one();
+            }
+        }
+
+        std::mutex _mutex;
+        std::condition_variable _workCond;
+        std::condition_variable _doneCond;
+        size_t _generation;
+        size_t _pending;
+        size_t _count;
+        const RangeFcn *_task;
+        std::exception_ptr _error;
+        bool _shutdown;
+        std::vector<std::thread> _threads;
+    };
+}
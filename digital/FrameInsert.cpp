@@ -9,6 +9,11 @@
 #include <algorithm> //min/max
 #include <complex>
 #include <cstdint>
+#include <utility>
+#include <vector>
+
+//number of encoded frame headers kept for reuse
+static const size_t HEADER_CACHE_SIZE = 16;
 
 /***********************************************************************
  * |PothosDoc Frame Insert
@@ -31,6 +36,12 @@
  * will be shifted to the last symbol of the padding buffer.
  * All other labels propagate with the same position.
  *
+ * <h2>Header cache</h2>
+ *
+ * The preamble and the encoded header only depend on the payload length,
+ * so the most recently used frame headers are kept in a small cache
+ * and the same read-only buffer is posted for frames of the same length.
+ *
  * |category /Digital
  * |keywords preamble frame sync
  * |alias /blocks/frame_insert
@@ -130,6 +141,7 @@ public:
     void setHeaderId(const unsigned char id)
     {
         _headerId = id;
+        _headerCache.clear();
     }
 
     unsigned char getHeaderId(void) const
@@ -218,32 +230,13 @@ public:
                 headBuff.length = headElems*sizeof(Type);
                 if (headBuff.length != 0) outputPort->postBuffer(headBuff);
 
-                //fill the preamble buffer
-                Pothos::BufferChunk newPreambleBuff(typeid(Type), _preambleBuff.elements());
-                std::memcpy(newPreambleBuff.as<void *>(), _preambleBuff.as<const void *>(), _preambleBuff.length);
-                auto p = newPreambleBuff.as<Type *>() + _syncWordWidth;
-
-                //encode the header field into bits
-                char headerBits[NUM_HEADER_BITS];
-                FrameHeaderFields headerFields;
-                headerFields.id = _headerId;
-                headerFields.length = 0;
+                //post the preamble buffer with the encoded header
+                size_t length = 0;
                 if (label.data.canConvert(typeid(size_t)))
                 {
-                    headerFields.length = label.data.template convert<size_t>()*label.width;
+                    length = label.data.template convert<size_t>()*label.width;
                 }
-                headerFields.chksum = headerFields.doChecksum();
-                encodeHeaderWord(headerBits, headerFields);
-
-                //encode header fields as BPSK into the preamble buffer
-                const auto sym = _preamble.back();
-                for (size_t i = 0; i < NUM_HEADER_BITS; i++)
-                {
-                    *p++ = (headerBits[i] != 0)?+sym:-sym;
-                }
-
-                //post the preamble buffer
-                outputPort->postBuffer(newPreambleBuff);
+                outputPort->postBuffer(this->getHeaderBuffer(length));
 
                 //remove header from the remaining buffer
                 inBuff.length -= headBuff.length;
@@ -294,8 +287,46 @@ public:
 
 private:
 
+    Pothos::BufferChunk getHeaderBuffer(const size_t length)
+    {
+        //reuse the cached header, most recently used entries are last
+        for (auto it = _headerCache.begin(); it != _headerCache.end(); ++it)
+        {
+            if (it->first != length) continue;
+            std::rotate(it, it+1, _headerCache.end());
+            return _headerCache.back().second;
+        }
+
+        //fill the preamble buffer
+        Pothos::BufferChunk newPreambleBuff(typeid(Type), _preambleBuff.elements());
+        std::memcpy(newPreambleBuff.as<void *>(), _preambleBuff.as<const void *>(), _preambleBuff.length);
+        auto p = newPreambleBuff.as<Type *>() + _syncWordWidth;
+
+        //encode the header field into bits
+        char headerBits[NUM_HEADER_BITS];
+        FrameHeaderFields headerFields;
+        headerFields.id = _headerId;
+        headerFields.length = length;
+        headerFields.chksum = headerFields.doChecksum();
+        encodeHeaderWord(headerBits, headerFields);
+
+        //encode header fields as BPSK into the preamble buffer
+        const auto sym = _preamble.back();
+        for (size_t i = 0; i < NUM_HEADER_BITS; i++)
+        {
+            *p++ = (headerBits[i] != 0)?+sym:-sym;
+        }
+
+        //the buffer is only read downstream, so it can be posted again
+        if (_headerCache.size() == HEADER_CACHE_SIZE) _headerCache.erase(_headerCache.begin());
+        _headerCache.emplace_back(length, newPreambleBuff);
+        return newPreambleBuff;
+    }
+
     void updatePreambleBuffer(void)
     {
+        _headerCache.clear();
+
         _syncWordWidth = _symbolWidth*_preamble.size();
         _preambleBuff = Pothos::BufferChunk(typeid(Type), _syncWordWidth+NUM_HEADER_BITS);
 
@@ -318,6 +349,7 @@ private:
     size_t _syncWordWidth;
     Pothos::BufferChunk _preambleBuff;
     Pothos::BufferChunk _paddingBuff;
+    std::vector<std::pair<size_t, Pothos::BufferChunk>> _headerCache; //payload length to encoded header
 };
 
 /***********************************************************************
@@ -2,13 +2,89 @@
 //                    2021 Nicholas Corgan
 // SPDX-License-Identifier: BSL-1.0
 
+#ifdef POTHOS_XSIMD
+#include "SIMD/DigitalBlocks_SIMD.hpp"
+#endif
+
 #include "FrameHelper.hpp"
+#include "common/ThreadPool.hpp"
 #include <Pothos/Framework.hpp>
 #include <cstring> //memcpy
 #include <iostream>
 #include <algorithm> //min/max
 #include <complex>
 #include <cstdint>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <atomic>
+#include <chrono>
+
+//
+// Implementation getters to be called on class construction
+//
+
+template <typename Type>
+using StridedWeightedSumFcn = void(*)(const Type*, const Type*, const size_t, const size_t, Type*, const size_t);
+
+template <typename Type>
+using PhasorMultiplyFcn = void(*)(const Type*, const size_t, Type*, const Type*, Type*, const size_t);
+
+#ifdef POTHOS_XSIMD
+
+template <typename Type>
+static StridedWeightedSumFcn<Type> getStridedWeightedSumFcn()
+{
+    return PothosCommsSIMD::stridedWeightedSumDispatch<Type>();
+}
+
+template <typename Type>
+static PhasorMultiplyFcn<Type> getPhasorMultiplyFcn()
+{
+    return PothosCommsSIMD::phasorMultiplyDispatch<Type>();
+}
+
+#else
+
+template <typename Type>
+static StridedWeightedSumFcn<Type> getStridedWeightedSumFcn()
+{
+    return [](const Type *in, const Type *coeffs, const size_t numCoeffs, const size_t stride, Type *out, const size_t num)
+    {
+        for (size_t i = 0; i < num; i++)
+        {
+            Type acc = 0;
+            for (size_t t = 0; t < numCoeffs; t++) acc += coeffs[t]*in[i+t*stride];
+            out[i] = acc;
+        }
+    };
+}
+
+template <typename Type>
+static PhasorMultiplyFcn<Type> getPhasorMultiplyFcn()
+{
+    return [](const Type *in, const size_t stride, Type *phasor, const Type *step, Type *out, const size_t num)
+    {
+        Type pr = phasor[0], pi = phasor[1];
+        for (size_t n = 0; n < num; n++)
+        {
+            const Type xr = in[2*n*stride+0], xi = in[2*n*stride+1];
+            out[2*n+0] = xr*pr - xi*pi;
+            out[2*n+1] = xr*pi + xi*pr;
+            const Type r = pr*step[0] - pi*step[1];
+            pi = pr*step[1] + pi*step[0];
+            pr = r;
+        }
+        phasor[0] = pr;
+        phasor[1] = pi;
+    };
+}
+
+#endif
+
+//number of outputs between exact phasor evaluations in the payload compensation
+static const size_t PHASOR_RENORM_SIZE = 1024;
 
 /***********************************************************************
  * |PothosDoc Frame Sync
@@ -57,6 +133,65 @@
  * The next downstream block may perform symbol detection
  * to remap the recovered symbols into data bits.
  *
+ * With cubic timing interpolation, the fractional timing offset
+ * is estimated from the phase transition at the header start,
+ * and every payload symbol is interpolated at the fractional offset
+ * with a 4-tap Lagrange (Farrow) interpolator.
+ * This keeps the symbol detection usable at low oversampling,
+ * such as a data width of 2 samples per symbol.
+ *
+ * The phase compensation of both modes uses a recursive phasor,
+ * which is evaluated exactly at the start of every 1024 outputs
+ * to bound the accumulated phase and amplitude error.
+ *
+ * <h2>Multiple transmitters</h2>
+ *
+ * Frames from several transmitter classes can be received in a single search.
+ * Additional preambles of the same length as the main preamble
+ * share the running sums, the search bounds, and the frequency estimate,
+ * and only the final correlation is computed for each preamble.
+ * The preamble with the largest correlation is used to decode the header.
+ * Frames are accepted when the decoded header ID matches the header ID
+ * or one of the additional header IDs, and the matched ID may be
+ * posted as a label at the first payload index.
+ *
+ * <h2>Frame search</h2>
+ *
+ * Every input offset is evaluated as the potential start of a frame in two stages.
+ * The coarse stage checks the input threshold and the envelope,
+ * and bounds the correlation magnitude from sums over each data symbol
+ * for a range of offsets at once.
+ * The fine stage refines the bound with the frequency offset estimate,
+ * and the full correlation is only computed for the remaining offsets.
+ * Both stages only rule out offsets that cannot produce a new correlation peak,
+ * so the frames found are the same as evaluating the full correlation everywhere.
+ * The search bounds can be disabled to evaluate the full correlation
+ * at every offset as a reference for the bounded search.
+ *
+ * With multiple threads, the search offsets of the input buffer are split
+ * into one contiguous segment per thread, and each thread records
+ * the offsets whose correlation exceeds the threshold in its segment.
+ * The recorded peaks are then merged in order with the same peak and duration rules,
+ * and the payload is forwarded from the calling thread.
+ * Offsets searched ahead of a found frame are kept for the next search.
+ *
+ * <h2>Statistics</h2>
+ *
+ * The following probes count the search and header decode outcomes
+ * since the block was created, and can be read while the block is running:
+ * <ul>
+ * <li>getSamplesSearched() - input offsets evaluated by the frame search</li>
+ * <li>getSearchTime() - cumulative time spent in the frame search in seconds</li>
+ * <li>getCoarseCandidates() - offsets that pass the coarse stage</li>
+ * <li>getFineEvaluations() - offsets evaluated with the full correlation</li>
+ * <li>getFramesDetected() - correlation peaks found and passed to header decode</li>
+ * <li>getHeaderErrors() - headers with uncorrectable Hamming errors</li>
+ * <li>getChecksumFailures() - headers that fail the checksum</li>
+ * <li>getHeaderIdRejects() - headers with an unexpected header ID</li>
+ * <li>getZeroLengthRejects() - headers without a payload length</li>
+ * <li>getAcceptedFrames() - frames forwarded to the output</li>
+ * </ul>
+ *
  * |category /Digital
  * |keywords preamble frame sync timing offset recover
  * |alias /blocks/frame_sync
@@ -75,6 +210,14 @@
  * |option [Timing recovery] "TIMING"
  * |option [Debug preamble] "DEBUG"
  *
+ * |param timingInterp[Timing Interpolation] The payload interpolation in the timing recovery mode.
+ * The nearest option forwards the input sample nearest to the symbol timing.
+ * The cubic option interpolates the symbol at the fractional timing offset.
+ * |default "NEAREST"
+ * |option [Nearest sample] "NEAREST"
+ * |option [Cubic] "CUBIC"
+ * |preview when(enum=outputMode, "TIMING")
+ *
  * |param preamble A vector of symbols representing the preamble.
  * |default [1, 1, -1]
  * |option [Barker Code 2] \[1, -1\]
@@ -86,6 +229,15 @@
  * The frame sync uses this ID to compare and to reject unrecognized frames.
  * |default 0x55
  *
+ * |param additionalHeaderIds [Additional Header IDs] A list of other 8-bit header IDs to accept.
+ * |default []
+ * |preview valid
+ *
+ * |param additionalPreambles [Additional Preambles] A list of other preambles to search for.
+ * Each preamble must have the same length as the main preamble.
+ * |default []
+ * |preview valid
+ *
  * |param symbolWidth [Symbol Width] The number of samples per preamble symbol.
  * This value should correspond to the symbol width used in the frame inserter block.
  * |default 20
@@ -122,23 +274,52 @@
  * |preview valid
  * |tab Labels
  *
+ * |param headerIdLabelId[Header ID Label ID] The label ID that carries the matched header ID.
+ * The label is posted at the first payload index and its data is the decoded header ID.
+ * The header ID label will not be produced when the label ID is not specified.
+ * |default ""
+ * |widget StringEntry()
+ * |preview valid
+ * |tab Labels
+ *
  * |param verboseMode[Verbose Mode] Enable debug verbose when frames are discovered.
  * |default false
  * |preview disable
  * |option [Enable] true
  * |option [Disable] false
  *
+ * |param numThreads[Num Threads] The number of threads used by the frame search.
+ * Use 0 for one thread per hardware thread.
+ * |default 1
+ * |preview valid
+ * |tab Advanced
+ *
+ * |param searchBounds[Search Bounds] Skip the search offsets ruled out by the correlation bounds.
+ * Disable to evaluate the full correlation at every search offset.
+ * The frames found are the same with either option.
+ * |default true
+ * |option [Enable] true
+ * |option [Disable] false
+ * |preview disable
+ * |tab Advanced
+ *
  * |factory /comms/frame_sync(dtype)
  * |setter setOutputMode(outputMode)
+ * |setter setTimingInterpolation(timingInterp)
  * |setter setPreamble(preamble)
  * |setter setHeaderId(headerId)
+ * |setter setAdditionalHeaderIds(additionalHeaderIds)
+ * |setter setAdditionalPreambles(additionalPreambles)
  * |setter setSymbolWidth(symbolWidth)
  * |setter setDataWidth(dataWidth)
  * |setter setFrameStartId(frameStartId)
  * |setter setFrameEndId(frameEndId)
  * |setter setPhaseOffsetID(phaseOffsetID)
+ * |setter setHeaderIdLabelId(headerIdLabelId)
  * |setter setInputThreshold(inputThreshold)
  * |setter setVerboseMode(verboseMode)
+ * |setter setNumThreads(numThreads)
+ * |setter setSearchBounds(searchBounds)
  **********************************************************************/
 template <typename Type>
 class FrameSync : public Pothos::Block
@@ -152,22 +333,45 @@ public:
     }
 
     FrameSync(void):
+        _preambles(1),
         _headerId(0),
         _symbolWidth(0),
         _dataWidth(0),
         _syncWordWidth(0),
         _frameWidth(0),
         _inputThreshold(0),
-        _verbose(false)
+        _verbose(false),
+        _numThreads(1),
+        _searchBounds(true),
+        _stridedWeightedSum(getStridedWeightedSumFcn<double>()),
+        _phasorMultiply(getPhasorMultiplyFcn<RealType>()),
+        _searchBegin(0),
+        _searchEnd(0),
+        _samplesSearched(0),
+        _searchTimeNs(0),
+        _coarseCandidates(0),
+        _fineEvaluations(0),
+        _framesDetected(0),
+        _headerErrors(0),
+        _checksumFailures(0),
+        _headerIdRejects(0),
+        _zeroLengthRejects(0),
+        _acceptedFrames(0)
     {
         this->setupInput(0, typeid(Type));
         this->setupOutput(0, typeid(Type));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setOutputMode));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getOutputMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setTimingInterpolation));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getTimingInterpolation));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setPreamble));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getPreamble));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setHeaderId));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getHeaderId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setAdditionalHeaderIds));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getAdditionalHeaderIds));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setAdditionalPreambles));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getAdditionalPreambles));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setSymbolWidth));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getSymbolWidth));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setDataWidth));
@@ -178,19 +382,48 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getFrameEndId));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setPhaseOffsetID));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getPhaseOffsetID));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setHeaderIdLabelId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getHeaderIdLabelId));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setInputThreshold));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getInputThreshold));
         this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setVerboseMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setNumThreads));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getNumThreads));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, setSearchBounds));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getSearchBounds));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getSamplesSearched));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getSearchTime));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getCoarseCandidates));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getFineEvaluations));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getFramesDetected));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getHeaderErrors));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getChecksumFailures));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getHeaderIdRejects));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getZeroLengthRejects));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FrameSync, getAcceptedFrames));
+        this->registerProbe("getSamplesSearched");
+        this->registerProbe("getSearchTime");
+        this->registerProbe("getCoarseCandidates");
+        this->registerProbe("getFineEvaluations");
+        this->registerProbe("getFramesDetected");
+        this->registerProbe("getHeaderErrors");
+        this->registerProbe("getChecksumFailures");
+        this->registerProbe("getHeaderIdRejects");
+        this->registerProbe("getZeroLengthRejects");
+        this->registerProbe("getAcceptedFrames");
 
         this->setHeaderId(0x55); //initial update
         this->setOutputMode("RAW"); //initial update
+        this->setTimingInterpolation("NEAREST"); //initial update
         this->setSymbolWidth(20); //initial update
         this->setDataWidth(4); //initial update
         this->setPreamble(std::vector<Type>(1, 1)); //initial update
         this->setFrameStartId("frameStart"); //initial update
         this->setFrameEndId(""); //initial update
         this->setPhaseOffsetID(""); //initial update
+        this->setHeaderIdLabelId(""); //initial update
         this->setInputThreshold(0.01); //initial update
+        this->setNumThreads(1); //initial update
     }
 
     void setOutputMode(const std::string &mode)
@@ -212,16 +445,34 @@ public:
         return _outputModeStr;
     }
 
+    void setTimingInterpolation(const std::string &interp)
+    {
+        if (interp == "NEAREST"){}
+        else if (interp == "CUBIC"){}
+        else throw Pothos::InvalidArgumentException("FrameSync::setTimingInterpolation("+interp+")", "unknown timing interpolation");
+        _timingCubic = (interp == "CUBIC");
+        _timingInterpStr = interp;
+    }
+
+    std::string getTimingInterpolation(void) const
+    {
+        return _timingInterpStr;
+    }
+
     void setPreamble(const std::vector<Type> preamble)
     {
         if (preamble.empty()) throw Pothos::InvalidArgumentException("FrameSync::setPreamble()", "preamble cannot be empty");
-        _preamble = preamble;
+        for (size_t i = 1; i < _preambles.size(); i++)
+        {
+            if (_preambles[i].size() != preamble.size()) throw Pothos::InvalidArgumentException("FrameSync::setPreamble()", "preamble length differs from the additional preambles");
+        }
+        _preambles.front() = preamble;
         this->updateSettings();
     }
 
     std::vector<Type> getPreamble(void) const
     {
-        return _preamble;
+        return _preambles.front();
     }
 
     void setHeaderId(const unsigned char id)
@@ -234,6 +485,32 @@ public:
         return _headerId;
     }
 
+    void setAdditionalHeaderIds(const std::vector<unsigned char> &ids)
+    {
+        _additionalHeaderIds = ids;
+    }
+
+    std::vector<unsigned char> getAdditionalHeaderIds(void) const
+    {
+        return _additionalHeaderIds;
+    }
+
+    void setAdditionalPreambles(const std::vector<std::vector<Type>> &preambles)
+    {
+        for (const auto &preamble : preambles)
+        {
+            if (preamble.size() != _preambles.front().size()) throw Pothos::InvalidArgumentException("FrameSync::setAdditionalPreambles()", "preamble length differs from the main preamble");
+        }
+        _preambles.resize(1);
+        _preambles.insert(_preambles.end(), preambles.begin(), preambles.end());
+        this->updateSettings();
+    }
+
+    std::vector<std::vector<Type>> getAdditionalPreambles(void) const
+    {
+        return std::vector<std::vector<Type>>(_preambles.begin()+1, _preambles.end());
+    }
+
     void setSymbolWidth(const size_t width)
     {
         if (width == 0) throw Pothos::InvalidArgumentException("FrameSync::setSymbolWidth()", "symbol width cannot be 0");
@@ -288,10 +565,21 @@ public:
         return _phaseOffsetId;
     }
 
+    void setHeaderIdLabelId(std::string id)
+    {
+        _headerIdLabelId = id;
+    }
+
+    std::string getHeaderIdLabelId(void) const
+    {
+        return _headerIdLabelId;
+    }
+
     void setInputThreshold(const RealType threshold)
     {
         if (threshold < 0) throw Pothos::InvalidArgumentException("FrameSync::setInputThreshold()", "threshold should be non-negative");
         _inputThreshold = threshold;
+        _searchEnd = _searchBegin; //discard searched peaks
     }
 
     RealType getInputThreshold(void) const
@@ -304,6 +592,79 @@ public:
         _verbose = enb;
     }
 
+    void setNumThreads(const size_t numThreads)
+    {
+        _numThreads = numThreads;
+        _pool.reset(new CommsCommon::ThreadPool(numThreads));
+        if (_searchContexts.size() < _pool->size()) _searchContexts.resize(_pool->size());
+        _workerPeaks.resize(_pool->size());
+    }
+
+    size_t getNumThreads(void) const
+    {
+        return _numThreads;
+    }
+
+    void setSearchBounds(const bool enb)
+    {
+        _searchBounds = enb;
+    }
+
+    bool getSearchBounds(void) const
+    {
+        return _searchBounds;
+    }
+
+    unsigned long long getSamplesSearched(void) const
+    {
+        return _samplesSearched.load(std::memory_order_relaxed);
+    }
+
+    double getSearchTime(void) const
+    {
+        return _searchTimeNs.load(std::memory_order_relaxed)/1e9;
+    }
+
+    unsigned long long getCoarseCandidates(void) const
+    {
+        return _coarseCandidates.load(std::memory_order_relaxed);
+    }
+
+    unsigned long long getFineEvaluations(void) const
+    {
+        return _fineEvaluations.load(std::memory_order_relaxed);
+    }
+
+    unsigned long long getFramesDetected(void) const
+    {
+        return _framesDetected.load(std::memory_order_relaxed);
+    }
+
+    unsigned long long getHeaderErrors(void) const
+    {
+        return _headerErrors.load(std::memory_order_relaxed);
+    }
+
+    unsigned long long getChecksumFailures(void) const
+    {
+        return _checksumFailures.load(std::memory_order_relaxed);
+    }
+
+    unsigned long long getHeaderIdRejects(void) const
+    {
+        return _headerIdRejects.load(std::memory_order_relaxed);
+    }
+
+    unsigned long long getZeroLengthRejects(void) const
+    {
+        return _zeroLengthRejects.load(std::memory_order_relaxed);
+    }
+
+    unsigned long long getAcceptedFrames(void) const
+    {
+        return _acceptedFrames.load(std::memory_order_relaxed);
+    }
+
     void work(void);
 
     void propagateLabels(const Pothos::InputPort *)
@@ -330,21 +691,91 @@ public:
         _phase = 0;
         _phaseInc = 0;
         _remainingPayload = 0;
+        _searchEnd = _searchBegin;
     }
 
 private:
 
-    void processEnvelope(const Type *in, RealType &scale);
+    //running sums and coarse metrics over one search range,
+    //index n of the sums holds the sum of elements before n
+    struct SearchContext
+    {
+        SearchContext(void):
+            sumsLen(0),
+            coarseLen(0),
+            coarseCandidates(0),
+            fineEvaluations(0)
+        {
+            return;
+        }
+
+        size_t sumsLen;
+        std::vector<double> absSums; //sum of |x|
+        std::vector<std::complex<double>> sampSums; //sum of x
+        std::vector<std::complex<double>> delaySums; //sum of x[n]*conj(x[n+delta])
+        std::vector<double> delayAbsSums; //sum of |x[n]*x[n+delta]|
+        std::vector<double> symAbsSums; //sum of |x[n]+...+x[n+dataWidth-1]| over every data width
+
+        //coarse search stage, a bound of the correlation magnitude per search offset
+        size_t coarseLen;
+        std::vector<double> coarseMetric;
+        std::vector<double> coarseCorr;
+        std::vector<double> coarseAbs;
+
+        //search statistics since the last publishSearchStats()
+        unsigned long long coarseCandidates;
+        unsigned long long fineEvaluations;
+    };
+
+    //the values calculated at a search offset
+    struct SearchPeak
+    {
+        unsigned long long offset;
+        size_t corrPeak;
+        RealType scale;
+        RealType deltaFc;
+        RealType phaseOff;
+        size_t preambleIndex;
+    };
+
+    void resetSearch(SearchContext &ctx, const size_t num);
+    void publishSearchStats(const std::chrono::high_resolution_clock::time_point &startTime, const size_t num);
+    void searchOffset(SearchContext &ctx, const Type *in, const size_t i, const size_t num, const double level, SearchPeak &peak);
+    void searchParallel(const Type *in, const unsigned long long position, const size_t num);
+    void updateSearchSums(SearchContext &ctx, const Type *in, const size_t num);
+    void updateCoarseSearch(SearchContext &ctx, const Type *in, const size_t begin, const size_t end);
+    double searchScaleBound(const SearchContext &ctx, const size_t i);
+    bool searchCandidate(const SearchContext &ctx, const Type *in, const size_t i, const double level);
+    bool isHeaderIdAccepted(const unsigned char id) const;
+    void processEnvelope(const Type *in, const std::vector<Type> &preamble, RealType &scale);
     void processFreqSync(const Type *in, RealType &deltaFc);
-    void processSyncWord(const Type *in, const RealType &deltaFc, const RealType &scale, RealType &phaseOff, size_t &corrPeak);
-    void processHeaderBits(const Type *in, const RealType &deltaFc, const RealType &scale, const RealType &phaseOff, size_t &firstBit, FrameHeaderFields &headerFields);
+    void processSyncWord(const Type *in, const std::vector<Type> &preamble, const RealType &deltaFc, const RealType &scale, RealType &phaseOff, size_t &corrPeak);
+    void processHeaderBits(const Type *in, const std::vector<Type> &preamble, const RealType &deltaFc, const RealType &scale, const RealType &phaseOff, size_t &firstBit, RealType &firstBitFrac, FrameHeaderFields &headerFields);
 
     void updateSettings(void)
     {
-        _syncWordWidth = _symbolWidth*_dataWidth*_preamble.size();
+        const size_t numSyms = _preambles.front().size();
+        _syncWordWidth = _symbolWidth*_dataWidth*numSyms;
         _frameWidth = _syncWordWidth+(NUM_HEADER_BITS*_dataWidth);
         _corrMagThresh = size_t(_syncWordWidth*CORR_MAG_PERCENT);
         _corrDurThresh = size_t(_syncWordWidth*CORR_DUR_PERCENT);
+
+        //the search bounds use the largest magnitude of every symbol over all preambles
+        _preambleMags.assign(numSyms, 0.0);
+        for (const auto &preamble : _preambles)
+        {
+            for (size_t s = 0; s < numSyms; s++) _preambleMags[s] = std::max<double>(_preambleMags[s], std::abs(preamble[s]));
+        }
+
+        //weights the differences of running sums over each preamble symbol
+        _coarseCoeffs.assign(numSyms+1, 0.0);
+        for (size_t s = 0; s < numSyms; s++)
+        {
+            _coarseCoeffs[s] -= _preambleMags[s];
+            _coarseCoeffs[s+1] += _preambleMags[s];
+        }
+
+        _searchEnd = _searchBegin; //discard searched peaks
     }
 
     //output mode
@@ -354,12 +785,19 @@ private:
     bool _outputModeTiming;
     bool _outputModeDebug;
 
+    //timing interpolation
+    std::string _timingInterpStr;
+    bool _timingCubic;
+
     //configuration
     std::string _frameStartId;
     std::string _frameEndId;
     std::string _phaseOffsetId;
-    std::vector<Type> _preamble;
+    std::string _headerIdLabelId;
+    std::vector<std::vector<Type>> _preambles; //main preamble first
+    std::vector<double> _preambleMags; //largest magnitude per symbol
     unsigned char _headerId; //unique id to check frame
+    std::vector<unsigned char> _additionalHeaderIds;
     size_t _symbolWidth; //width of a preamble symbol
     size_t _dataWidth; //width of a data dymbol
     size_t _syncWordWidth; //preamble sync portion width
@@ -375,6 +813,7 @@ private:
     RealType _deltaFcMax;
     RealType _phaseOffMax;
     RealType _scaleAtMax;
+    size_t _preambleAtMax;
 
     //track payload after frame found
     size_t _remainingPayload;
@@ -382,6 +821,44 @@ private:
     //calculated output offset corrections
     RealType _phase;
     RealType _phaseInc;
+
+    //search state, one context per worker of the pool
+    size_t _numThreads;
+    std::unique_ptr<CommsCommon::ThreadPool> _pool;
+    bool _searchBounds; //false evaluates every offset in full
+    std::vector<SearchContext> _searchContexts;
+    std::vector<double> _coarseCoeffs;
+    StridedWeightedSumFcn<double> _stridedWeightedSum;
+
+    //payload compensation
+    PhasorMultiplyFcn<RealType> _phasorMultiply;
+    void compensatePayload(const Type *in, const size_t inStride, const size_t phaseStride, Type *out, const size_t num);
+    void interpolatePayload(const Type *in, Type *out, const size_t num);
+
+    //cubic timing interpolation, the first payload symbol is
+    //interpolated between input samples timingBase and timingBase+1
+    size_t _timingBase;
+    RealType _timingTaps[4];
+
+    //peaks above threshold from the parallel search,
+    //for the absolute input offsets in [searchBegin, searchEnd)
+    unsigned long long _searchBegin;
+    unsigned long long _searchEnd;
+    std::vector<SearchPeak> _searchPeaks;
+    std::vector<std::vector<SearchPeak>> _workerPeaks;
+
+    //statistics, the hot loops count into the search contexts,
+    //the totals are published once per search for the probes
+    std::atomic<unsigned long long> _samplesSearched;
+    std::atomic<unsigned long long> _searchTimeNs;
+    std::atomic<unsigned long long> _coarseCandidates;
+    std::atomic<unsigned long long> _fineEvaluations;
+    std::atomic<unsigned long long> _framesDetected;
+    std::atomic<unsigned long long> _headerErrors;
+    std::atomic<unsigned long long> _checksumFailures;
+    std::atomic<unsigned long long> _headerIdRejects;
+    std::atomic<unsigned long long> _zeroLengthRejects;
+    std::atomic<unsigned long long> _acceptedFrames;
 };
 
 /***********************************************************************
@@ -420,11 +897,7 @@ void FrameSync<Type>::work(void)
     {
         const auto N = std::min(_remainingPayload, this->workInfo().minElements);
 
-        for (size_t i = 0; i < N; i++)
-        {
-            out[i] = in[i]*std::polar<RealType>(_scaleAtMax, _phase);
-            _phase += _phaseInc;
-        }
+        this->compensatePayload(in, 1, 1, out, N);
 
         _remainingPayload -= N;
         inPort->consume(N);
@@ -437,16 +910,19 @@ void FrameSync<Type>::work(void)
      **************************************************************/
     else if (_remainingPayload != 0 and _outputModeTiming)
     {
-        auto N = std::min(_remainingPayload, inPort->elements());
+        //the interpolator needs the samples around the last symbol
+        const size_t history = _timingCubic?(_timingBase+3):_dataWidth;
+        size_t N = 0;
+        if (inPort->elements() >= history) N = std::min(_remainingPayload, inPort->elements()-history+_dataWidth);
         N = std::min(N/_dataWidth, outPort->elements());
-        if (N == 0) inPort->setReserve(_dataWidth);
+        if (N == 0) inPort->setReserve(history);
 
-        for (size_t i = 0; i < N; i++)
+        if (_timingCubic)
         {
-            const auto sym = in[i*_dataWidth];
-            out[i] = sym*std::polar<RealType>(_scaleAtMax, _phase);
-            _phase += _phaseInc*_dataWidth;
+            this->interpolatePayload(in, out, N);
+            this->compensatePayload(out, 1, _dataWidth, out, N);
         }
+        else this->compensatePayload(in, _dataWidth, _dataWidth, out, N);
 
         const size_t consumed = N*_dataWidth;
         _remainingPayload -= consumed;
@@ -465,33 +941,42 @@ void FrameSync<Type>::work(void)
         inPort->setReserve(requireMin);
         return;
     }
+    const auto startTime = std::chrono::high_resolution_clock::now();
     const auto N = inPort->elements()-requireMin+1;
+    const auto position = inPort->totalElements();
+    const bool parallel = _pool->size() > 1;
+    if (parallel) this->searchParallel(in, position, N);
+    else this->resetSearch(_searchContexts.front(), N);
+    size_t peakIndex = 0;
 
     for (size_t i = 0; i < N; i++)
     {
         //process the potential frame to discover these values
-        RealType scale = 0;
-        RealType deltaFc = 0;
-        RealType phaseOff = 0;
-        size_t corrPeak = 0;
-
-        //calculate the scaling value, and check for consistent envelope
-        this->processEnvelope(in+i, scale);
-
-        //calculate the frequency offset as if this was the frame start
-        if (scale != 0) this->processFreqSync(in+i, deltaFc);
+        SearchPeak peak;
+        peak.corrPeak = 0;
 
-        //use the frequency offset to calculate the correlation value
-        if (scale != 0) this->processSyncWord(in+i, deltaFc, scale, phaseOff, corrPeak);
+        //the parallel search recorded every offset above the threshold,
+        //otherwise search this offset against the current peak
+        if (parallel)
+        {
+            while (peakIndex < _searchPeaks.size() and _searchPeaks[peakIndex].offset < position+i) peakIndex++;
+            if (peakIndex < _searchPeaks.size() and _searchPeaks[peakIndex].offset == position+i) peak = _searchPeaks[peakIndex];
+        }
+        else
+        {
+            const double level = double(std::max(_maxCorrPeak, _corrMagThresh)) + 1;
+            this->searchOffset(_searchContexts.front(), in, i, N, level, peak);
+        }
 
         //if this correlation value is larger, record the state
-        if (corrPeak > _maxCorrPeak and corrPeak > _corrMagThresh)
+        if (peak.corrPeak > _maxCorrPeak and peak.corrPeak > _corrMagThresh)
         {
-            _maxCorrPeak = corrPeak;
+            _maxCorrPeak = peak.corrPeak;
             _countSinceMax = 0;
-            _deltaFcMax = deltaFc;
-            _phaseOffMax = phaseOff;
-            _scaleAtMax = scale;
+            _deltaFcMax = peak.deltaFc;
+            _phaseOffMax = peak.phaseOff;
+            _preambleAtMax = peak.preambleIndex;
+            _scaleAtMax = peak.scale;
             //std::cout << " new _maxCorrPeak = " << _maxCorrPeak << std::endl;
         }
         _countSinceMax++;
@@ -510,16 +995,19 @@ void FrameSync<Type>::work(void)
             std::cout << " deltaFcMax = " << _deltaFcMax << std::endl;
             std::cout << " phaseOffMax = " << _phaseOffMax << std::endl;
             std::cout << " scaleAtMax = " << _scaleAtMax << std::endl;
+            std::cout << " preambleAtMax = " << _preambleAtMax << std::endl;
         }
 
         _maxCorrPeak = 0; //reset for next time
+        _framesDetected.fetch_add(1, std::memory_order_relaxed);
 
         //now that the frame was found, process the length field
         //and determine sample offset (used in timing recovery mode)
         size_t firstBit = 0;
+        RealType firstBitFrac = 0;
         size_t frameOffset = i-_countSinceMax;
         FrameHeaderFields headerFields;
-        this->processHeaderBits(in+frameOffset, _deltaFcMax, _scaleAtMax, _phaseOffMax, firstBit, headerFields);
+        this->processHeaderBits(in+frameOffset, _preambles[_preambleAtMax], _deltaFcMax, _scaleAtMax, _phaseOffMax, firstBit, firstBitFrac, headerFields);
 
         //print summary
         if (_verbose)
@@ -530,11 +1018,28 @@ void FrameSync<Type>::work(void)
             std::cout << " chksum = 0x" << std::hex << int(headerFields.chksum) << std::dec << std::endl;
         }
 
-        if (headerFields.error) continue; //error correction not possible
-        if (headerFields.chksum != headerFields.doChecksum()) continue; //checksum failed
-        if (headerFields.id != _headerId) continue; //reject unknown id
-        if (headerFields.length == 0) continue; //length not provided
+        if (headerFields.error) //error correction not possible
+        {
+            _headerErrors.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (headerFields.chksum != headerFields.doChecksum()) //checksum failed
+        {
+            _checksumFailures.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (not this->isHeaderIdAccepted(headerFields.id)) //reject unknown id
+        {
+            _headerIdRejects.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (headerFields.length == 0) //length not provided
+        {
+            _zeroLengthRejects.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
         const size_t length = headerFields.length;
+        _acceptedFrames.fetch_add(1, std::memory_order_relaxed);
 
         //Label width is specified based on the output mode.
         //Width may be divided down by an upstream time recovery block.
@@ -554,6 +1059,7 @@ void FrameSync<Type>::work(void)
         {
             std::cout << "FRAME VALID \n";
             std::cout << " firstBit = " << firstBit << std::endl;
+            std::cout << " firstBitFrac = " << firstBitFrac << std::endl;
             std::cout << " sampOffset = " << (int(firstBit)-int(_syncWordWidth)) << std::endl;
             std::cout << " frameOffset = " << frameOffset << std::endl;
             std::cout << " payloadOffset = " << payloadOffset << std::endl;
@@ -570,6 +1076,21 @@ void FrameSync<Type>::work(void)
             payloadOffset -= backup;
         }
 
+        //interpolate the payload at the fractional timing offset,
+        //two samples before the payload are kept for the interpolator
+        if (_outputModeTiming and _timingCubic)
+        {
+            const RealType pos = 2 + firstBitFrac;
+            _timingBase = size_t(std::floor(pos));
+            const RealType mu = pos - _timingBase;
+            _timingTaps[0] = -mu*(mu-1)*(mu-2)/6;
+            _timingTaps[1] = (mu+1)*(mu-1)*(mu-2)/2;
+            _timingTaps[2] = -(mu+1)*mu*(mu-2)/2;
+            _timingTaps[3] = (mu+1)*mu*(mu-1)/6;
+            _phase += _phaseInc*firstBitFrac;
+            payloadOffset -= 2;
+        }
+
         //produce a phase offset label at the first payload index
         if (not _phaseOffsetId.empty()) outPort->postLabel(
             _phaseOffsetId, _phase, labelStart, labelWidth);
@@ -578,22 +1099,396 @@ void FrameSync<Type>::work(void)
         if (not _frameStartId.empty()) outPort->postLabel(
             _frameStartId, length, labelStart, labelWidth);
 
+        //produce a header id label at the first payload index
+        if (not _headerIdLabelId.empty()) outPort->postLabel(
+            _headerIdLabelId, int(headerFields.id), labelStart, labelWidth);
+
         //produce an end of frame label at the last payload index
         if (not _frameEndId.empty()) outPort->postLabel(
             _frameEndId, length, labelEnd, labelWidth);
 
+        this->publishSearchStats(startTime, i+1);
         inPort->setReserve(0);
         inPort->consume(payloadOffset);
         return;
     }
+    this->publishSearchStats(startTime, N);
     inPort->consume(N);
 }
 
+/***********************************************************************
+ * Apply the scale and phase compensation to num outputs from every
+ * inStride input elements, where each output spans phaseStride input samples,
+ * and advance the phase for the consumed input
+ **********************************************************************/
+template <typename Type>
+void FrameSync<Type>::compensatePayload(const Type *in, const size_t inStride, const size_t phaseStride, Type *out, const size_t num)
+{
+    const auto phaseStep = _phaseInc*phaseStride;
+    const auto step = std::polar<RealType>(1, phaseStep);
+    for (size_t i = 0; i < num; i += PHASOR_RENORM_SIZE)
+    {
+        const size_t n = std::min(num-i, PHASOR_RENORM_SIZE);
+        auto phasor = std::polar<RealType>(_scaleAtMax, _phase);
+        _phasorMultiply(
+            reinterpret_cast<const RealType *>(in+i*inStride), inStride,
+            reinterpret_cast<RealType *>(&phasor),
+            reinterpret_cast<const RealType *>(&step),
+            reinterpret_cast<RealType *>(out+i), n);
+        _phase += phaseStep*n;
+    }
+}
+
+/***********************************************************************
+ * Interpolate num payload symbols from every data width input samples,
+ * with the cubic taps between samples timingBase and timingBase+1
+ **********************************************************************/
+template <typename Type>
+void FrameSync<Type>::interpolatePayload(const Type *in, Type *out, const size_t num)
+{
+    const RealType c0 = _timingTaps[0], c1 = _timingTaps[1], c2 = _timingTaps[2], c3 = _timingTaps[3];
+    const Type *x = in + _timingBase - 1;
+    for (size_t i = 0; i < num; i++)
+    {
+        out[i] = c0*x[0] + c1*x[1] + c2*x[2] + c3*x[3];
+        x += _dataWidth;
+    }
+}
+
+/***********************************************************************
+ * Prepare the search context for num offsets of a new input buffer
+ **********************************************************************/
+template <typename Type>
+void FrameSync<Type>::resetSearch(SearchContext &ctx, const size_t num)
+{
+    ctx.sumsLen = 0;
+    ctx.coarseLen = 0;
+    ctx.coarseMetric.resize(num);
+}
+
+/***********************************************************************
+ * Add the counts of the search contexts and the time since startTime
+ * to the statistics, after num offsets were searched by this work call
+ **********************************************************************/
+template <typename Type>
+void FrameSync<Type>::publishSearchStats(const std::chrono::high_resolution_clock::time_point &startTime, const size_t num)
+{
+    for (auto &ctx : _searchContexts)
+    {
+        _coarseCandidates.fetch_add(ctx.coarseCandidates, std::memory_order_relaxed);
+        _fineEvaluations.fetch_add(ctx.fineEvaluations, std::memory_order_relaxed);
+        ctx.coarseCandidates = 0;
+        ctx.fineEvaluations = 0;
+    }
+    const auto elapsed = std::chrono::high_resolution_clock::now() - startTime;
+    _searchTimeNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), std::memory_order_relaxed);
+    _samplesSearched.fetch_add(num, std::memory_order_relaxed);
+}
+
+/***********************************************************************
+ * Search offset i of num offsets in the context:
+ * The coarse stage bounds the correlation for a range of offsets at once,
+ * the fine stage rules out more offsets before the full computation.
+ * The peak is left at zero when the correlation cannot reach the level.
+ * Without the search bounds, every offset gets the full computation.
+ **********************************************************************/
+template <typename Type>
+void FrameSync<Type>::searchOffset(SearchContext &ctx, const Type *in, const size_t i, const size_t num, const double level, SearchPeak &peak)
+{
+    peak.corrPeak = 0;
+    peak.scale = 0;
+    peak.deltaFc = 0;
+    peak.phaseOff = 0;
+    peak.preambleIndex = 0;
+
+    if (_searchBounds)
+    {
+        if (i == ctx.coarseLen) this->updateCoarseSearch(ctx, in, i, std::min(num, i+_frameWidth));
+        if (ctx.coarseMetric[i] < level) return;
+        ctx.coarseCandidates++;
+        if (not this->searchCandidate(ctx, in, i, level)) return;
+    }
+    else ctx.coarseCandidates++;
+    ctx.fineEvaluations++;
+
+    //the frequency offset estimate does not depend on the preamble
+    bool freqSyncDone = false;
+    for (size_t p = 0; p < _preambles.size(); p++)
+    {
+        //calculate the scaling value, and check for consistent envelope
+        RealType scale = 0;
+        this->processEnvelope(in+i, _preambles[p], scale);
+        if (scale == 0) continue;
+
+        //calculate the frequency offset as if this was the frame start
+        if (not freqSyncDone) this->processFreqSync(in+i, peak.deltaFc);
+        freqSyncDone = true;
+
+        //use the frequency offset to calculate the correlation value,
+        //and keep the preamble with the largest correlation
+        RealType phaseOff = 0;
+        size_t corrPeak = 0;
+        this->processSyncWord(in+i, _preambles[p], peak.deltaFc, scale, phaseOff, corrPeak);
+        if (p != 0 and corrPeak <= peak.corrPeak) continue;
+        peak.corrPeak = corrPeak;
+        peak.scale = scale;
+        peak.phaseOff = phaseOff;
+        peak.preambleIndex = p;
+    }
+}
+
+/***********************************************************************
+ * Check the decoded header ID against the accepted IDs
+ **********************************************************************/
+template <typename Type>
+bool FrameSync<Type>::isHeaderIdAccepted(const unsigned char id) const
+{
+    if (id == _headerId) return true;
+    return std::find(_additionalHeaderIds.begin(), _additionalHeaderIds.end(), id) != _additionalHeaderIds.end();
+}
+
+/***********************************************************************
+ * Search num offsets of the input buffer at the absolute input position
+ * on the thread pool, recording every offset above the threshold:
+ * The values at an offset only depend on the input samples,
+ * so peaks recorded ahead of the last found frame are kept,
+ * and only the offsets past the recorded range are searched.
+ * Each worker searches one contiguous segment with its own running sums,
+ * the segments overlap by the frame width of input samples.
+ **********************************************************************/
+template <typename Type>
+void FrameSync<Type>::searchParallel(const Type *in, const unsigned long long position, const size_t num)
+{
+    //drop the recorded peaks before this buffer
+    if (position < _searchBegin or position > _searchEnd) _searchEnd = position;
+    if (_searchEnd == position) _searchPeaks.clear();
+    _searchPeaks.erase(_searchPeaks.begin(), std::lower_bound(_searchPeaks.begin(), _searchPeaks.end(), position,
+        [](const SearchPeak &peak, const unsigned long long offset){return peak.offset < offset;}));
+    _searchBegin = position;
+
+    //search the offsets past the recorded range
+    const size_t first = size_t(_searchEnd - position);
+    if (first >= num) return;
+    const double level = double(_corrMagThresh) + 1;
+    _pool->parallelFor(num-first, [&](const size_t index, const size_t begin, const size_t end)
+    {
+        auto &ctx = _searchContexts[index];
+        auto &peaks = _workerPeaks[index];
+        const Type *segment = in+first+begin;
+        const size_t segmentLen = end-begin;
+        this->resetSearch(ctx, segmentLen);
+        peaks.clear();
+        for (size_t i = 0; i < segmentLen; i++)
+        {
+            SearchPeak peak;
+            this->searchOffset(ctx, segment, i, segmentLen, level, peak);
+            if (peak.corrPeak <= _corrMagThresh) continue;
+            peak.offset = position+first+begin+i;
+            peaks.push_back(peak);
+        }
+    });
+
+    //the segments are in order of the worker index
+    for (auto &peaks : _workerPeaks)
+    {
+        _searchPeaks.insert(_searchPeaks.end(), peaks.begin(), peaks.end());
+        peaks.clear();
+    }
+    _searchEnd = position+num;
+}
+
+/***********************************************************************
+ * Extend the running sums of the search context to num elements
+ **********************************************************************/
+template <typename Type>
+void FrameSync<Type>::updateSearchSums(SearchContext &ctx, const Type *in, const size_t num)
+{
+    if (ctx.sumsLen >= num) return;
+    ctx.absSums.resize(num+1);
+    ctx.sampSums.resize(num+1);
+    ctx.delaySums.resize(num+1);
+    ctx.delayAbsSums.resize(num+1);
+    ctx.symAbsSums.resize(num+1);
+    if (ctx.sumsLen == 0)
+    {
+        ctx.absSums[0] = 0;
+        ctx.sampSums[0] = 0;
+        ctx.delaySums[0] = 0;
+        ctx.delayAbsSums[0] = 0;
+        ctx.symAbsSums[0] = 0;
+    }
+
+    //delay products are indexed by the first sample of the pair,
+    //data symbol sums are accumulated every data width from the first sample
+    const size_t delta = _symbolWidth*_dataWidth/2;
+    for (size_t n = ctx.sumsLen; n < num; n++)
+    {
+        const std::complex<double> x(in[n]);
+        ctx.absSums[n+1] = ctx.absSums[n] + std::sqrt(std::norm(x));
+        ctx.sampSums[n+1] = ctx.sampSums[n] + x;
+        if (n+1 < _dataWidth) ctx.symAbsSums[n+1] = 0;
+        else ctx.symAbsSums[n+1] = ctx.symAbsSums[n+1-_dataWidth] + std::sqrt(std::norm(ctx.sampSums[n+1] - ctx.sampSums[n+1-_dataWidth]));
+        if (n < delta) continue;
+        const std::complex<double> q = std::complex<double>(in[n-delta])*std::conj(x);
+        ctx.delaySums[n-delta+1] = ctx.delaySums[n-delta] + q;
+        ctx.delayAbsSums[n-delta+1] = ctx.delayAbsSums[n-delta] + std::sqrt(std::norm(q));
+    }
+    ctx.sumsLen = num;
+}
+
+/***********************************************************************
+ * Upper bound of the scale calculated by the envelope at offset i
+ * over all preambles, or zero when the rough averages of the envelope
+ * reject the offset for every preamble.
+ * Comparisons leave a margin for the rounding differences between the
+ * running sums and the full computation.
+ **********************************************************************/
+template <typename Type>
+double FrameSync<Type>::searchScaleBound(const SearchContext &ctx, const size_t i)
+{
+    static const double tol = 1e-3;
+    const size_t width = _symbolWidth*_dataWidth;
+    const size_t begin0 = _dataWidth, end0 = width/2;
+    const size_t begin1 = _syncWordWidth-width/2, end1 = _syncWordWidth-_dataWidth;
+    const double sum0 = (ctx.absSums[i+end0] - ctx.absSums[i+begin0])/(end0-begin0);
+    const double sum1 = (ctx.absSums[i+end1] - ctx.absSums[i+begin1])/(end1-begin1);
+    if (sum0 < _inputThreshold*(1-tol)) return 0;
+    if (sum1 < _inputThreshold*(1-tol)) return 0;
+    double scale = 0;
+    for (const auto &preamble : _preambles)
+    {
+        const double norm0 = sum0/std::abs(preamble.front());
+        const double norm1 = sum1/std::abs(preamble.back());
+        const double ratio = norm0/norm1;
+        if (ratio > 2*(1+tol) or ratio < 0.5*(1-tol)) continue;
+        scale = std::max(scale, (1+tol)*2.0/(norm0 + norm1));
+    }
+    return scale;
+}
+
+/***********************************************************************
+ * Coarse search stage for the offsets in [begin, end):
+ * Without the frequency offset estimate, the correlation magnitude
+ * is bounded by the magnitudes of the sums over each data symbol,
+ * plus the largest rotation of any frequency correction within a data symbol.
+ * The weighted sums over every preamble symbol are evaluated for
+ * consecutive offsets at once from the running sums.
+ * The metric is the bound of the correlation peak at each offset,
+ * or zero when the input threshold or the envelope rejects the offset.
+ **********************************************************************/
+template <typename Type>
+void FrameSync<Type>::updateCoarseSearch(SearchContext &ctx, const Type *in, const size_t begin, const size_t end)
+{
+    static const double tol = 1e-3;
+    ctx.coarseLen = end;
+
+    //degenerate window sizes are left to the full computation
+    const size_t width = _symbolWidth*_dataWidth;
+    const size_t delta = width/2;
+    if (width < delta + 2*_dataWidth)
+    {
+        std::fill(ctx.coarseMetric.begin()+begin, ctx.coarseMetric.begin()+end, std::numeric_limits<double>::infinity());
+        return;
+    }
+
+    //the sums cover the frame width of the last offset
+    this->updateSearchSums(ctx, in, end+_frameWidth-1);
+
+    //data symbol magnitudes and amplitude totals weighted by the preamble
+    const size_t num = end-begin;
+    ctx.coarseCorr.resize(num);
+    ctx.coarseAbs.resize(num);
+    _stridedWeightedSum(ctx.symAbsSums.data()+begin, _coarseCoeffs.data(), _coarseCoeffs.size(), width, ctx.coarseCorr.data(), num);
+    _stridedWeightedSum(ctx.absSums.data()+begin, _coarseCoeffs.data(), _coarseCoeffs.size(), width, ctx.coarseAbs.data(), num);
+
+    //the frequency offset estimate is at most pi over delta
+    const double rotation = M_PI/delta*(_dataWidth-1)/2;
+    const double thresh = _inputThreshold*(1-tol);
+    for (size_t k = 0; k < num; k++)
+    {
+        const size_t i = begin+k;
+        ctx.coarseMetric[i] = 0;
+
+        //spot check the amplitude near the sync word edges
+        if (ctx.absSums[i+_dataWidth+1] - ctx.absSums[i+_dataWidth] < thresh) continue;
+        if (ctx.absSums[i+_syncWordWidth-_dataWidth+1] - ctx.absSums[i+_syncWordWidth-_dataWidth] < thresh) continue;
+
+        const double scale = this->searchScaleBound(ctx, i);
+        ctx.coarseMetric[i] = scale*(ctx.coarseCorr[k] + (rotation + tol)*ctx.coarseAbs[k]);
+    }
+}
+
+/***********************************************************************
+ * Fine search stage, rule out search offsets that cannot record a new correlation peak:
+ * The correlation magnitude is bounded by splitting the sync word
+ * into blocks: each block contributes at most the magnitude of its sum
+ * plus the rotation of the frequency offset estimate within the block.
+ * The blocks are halved until the bound is below the required peak,
+ * or until they are as short as a data symbol (then the offset is a candidate).
+ * Comparisons leave a margin for the rounding differences between the
+ * running sums and the full computation, so that the frames found are
+ * identical to evaluating every offset with the full computation.
+ **********************************************************************/
+template <typename Type>
+bool FrameSync<Type>::searchCandidate(const SearchContext &ctx, const Type *in, const size_t i, const double level)
+{
+    static const double tol = 1e-3;
+    const auto sumAbs = [&](const size_t begin, const size_t end)
+    {
+        return ctx.absSums[i+end] - ctx.absSums[i+begin];
+    };
+
+    //spot check the amplitude near the sync word edges
+    if (std::abs(in[i+_dataWidth]) < _inputThreshold) return false;
+    if (std::abs(in[i+_syncWordWidth-_dataWidth]) < _inputThreshold) return false;
+
+    //degenerate window sizes are left to the full computation
+    const size_t width = _symbolWidth*_dataWidth;
+    const size_t delta = width/2;
+    if (width < delta + 2*_dataWidth) return true;
+
+    //rough average of amplitude at the beginning and the end
+    const double scale = this->searchScaleBound(ctx, i);
+    if (scale == 0) return false;
+
+    //bound the frequency offset estimate over the last preamble symbol,
+    //the rounding error of the sum limits the error of its angle
+    const size_t freqBegin = _syncWordWidth - width + _dataWidth;
+    const size_t freqEnd = _syncWordWidth - delta - _dataWidth;
+    const auto K = ctx.delaySums[i+freqEnd] - ctx.delaySums[i+freqBegin];
+    const double err = tol*(ctx.delayAbsSums[i+freqEnd] - ctx.delayAbsSums[i+freqBegin]);
+    double argMax = M_PI;
+    if (freqEnd == freqBegin) argMax = 0;
+    else if (std::abs(K) > err) argMax = std::min(M_PI, std::abs(std::arg(K)) + std::asin(err/std::abs(K)));
+    const double freqMax = argMax/delta;
+
+    //a new peak must reach the level
+    for (size_t block = width;; block = (block+1)/2)
+    {
+        double bound = 0, total = 0;
+        for (size_t s = 0; s < _preambleMags.size(); s++)
+        {
+            double symBound = 0, symTotal = 0;
+            for (size_t b0 = s*width; b0 < (s+1)*width; b0 += block)
+            {
+                const size_t b1 = std::min(b0+block, (s+1)*width);
+                const double blockTotal = sumAbs(b0, b1);
+                symBound += std::sqrt(std::norm(ctx.sampSums[i+b1] - ctx.sampSums[i+b0])) + freqMax*(b1-b0-1)/2*blockTotal;
+                symTotal += blockTotal;
+            }
+            bound += _preambleMags[s]*symBound;
+            total += _preambleMags[s]*symTotal;
+        }
+        if (scale*(bound + tol*total) < level) return false;
+        if (block <= _dataWidth) return true;
+    }
+}
+
 /***********************************************************************
  * Process the envelope of the frame preamble
  **********************************************************************/
 template <typename Type>
-void FrameSync<Type>::processEnvelope(const Type *in, RealType &scale)
+void FrameSync<Type>::processEnvelope(const Type *in, const std::vector<Type> &preamble, RealType &scale)
 {
     scale = 0;
 
@@ -611,7 +1506,7 @@ void FrameSync<Type>::processEnvelope(const Type *in, RealType &scale)
     }
     sum0 /= (end0-begin0);
     if (sum0 < _inputThreshold) return;
-    sum0 /= std::abs(_preamble.front());
+    sum0 /= std::abs(preamble.front());
 
     //get a rough average of amplitude at the end
     RealType sum1 = 0;
@@ -623,7 +1518,7 @@ void FrameSync<Type>::processEnvelope(const Type *in, RealType &scale)
     }
     sum1 /= (end1-begin1);
     if (sum1 < _inputThreshold) return;
-    sum1 /= std::abs(_preamble.back());
+    sum1 /= std::abs(preamble.back());
 
     //check for consistent amplitude across the frame
     const auto ratio = sum0/sum1;
@@ -643,7 +1538,7 @@ void FrameSync<Type>::processFreqSync(const Type *in, RealType &deltaFc)
     const size_t width = _symbolWidth*_dataWidth;
 
     //offset into the start of the final preamble symbol
-    auto syms = in + width*(_preamble.size()-1);
+    auto syms = in + _syncWordWidth - width;
 
     //difference between any two compare samples
     const size_t delta = width/2;
@@ -667,16 +1562,16 @@ void FrameSync<Type>::processFreqSync(const Type *in, RealType &deltaFc)
  * Process the sync word to find the max correlation
  **********************************************************************/
 template <typename Type>
-void FrameSync<Type>::processSyncWord(const Type *in, const RealType &deltaFc, const RealType &scale, RealType &phaseOff, size_t &corrPeak)
+void FrameSync<Type>::processSyncWord(const Type *in, const std::vector<Type> &preamble, const RealType &deltaFc, const RealType &scale, RealType &phaseOff, size_t &corrPeak)
 {
     //using scale and frequency offset, calculate correlation
     Type L = 0;
     RealType freqCorr = 0;
     auto frameSyms = in;
     const auto width = _symbolWidth*_dataWidth;
-    for (size_t i = 0; i < _preamble.size(); i++)
+    for (size_t i = 0; i < preamble.size(); i++)
     {
-        const auto sym = std::conj(_preamble[i]);
+        const auto sym = std::conj(preamble[i]);
         for (size_t j = 0; j < width; j++)
         {
             auto frameSym = *frameSyms++;
@@ -696,12 +1591,13 @@ void FrameSync<Type>::processSyncWord(const Type *in, const RealType &deltaFc, c
  * Process the length bits to get a symbol count
  **********************************************************************/
 template <typename Type>
-void FrameSync<Type>::processHeaderBits(const Type *in, const RealType &deltaFc, const RealType &scale, const RealType &phaseOff, size_t &firstBit, FrameHeaderFields &headerFields)
+void FrameSync<Type>::processHeaderBits(const Type *in, const std::vector<Type> &preamble, const RealType &deltaFc, const RealType &scale, const RealType &phaseOff, size_t &firstBit, RealType &firstBitFrac, FrameHeaderFields &headerFields)
 {
     firstBit = 0;
+    firstBitFrac = 0;
 
     //the last preamble symbol is used to encode the phase shifts
-    const auto sym = std::conj(_preamble.back());
+    const auto sym = std::conj(preamble.back());
 
     //use the intentional phase transition at the header start
     //to determine the optimal sampling offset to decode BPSK
@@ -723,6 +1619,18 @@ void FrameSync<Type>::processHeaderBits(const Type *in, const RealType &deltaFc,
     //never found the peak, probably not a frame
     if (firstBitPeak == 0) return;
 
+    //the fractional offset of the peak from a parabola through its neighbors
+    if (firstBit+1 < _frameWidth)
+    {
+        const auto bitAt = [&](const size_t i)
+        {
+            return (in[i]*std::polar<RealType>(scale, phaseOff + deltaFc*i)*sym).real();
+        };
+        const RealType y0 = bitAt(firstBit-1), y1 = firstBitPeak, y2 = bitAt(firstBit+1);
+        const RealType den = y0 - 2*y1 + y2;
+        if (den > 0) firstBitFrac = std::max<RealType>(-0.5, std::min<RealType>(0.5, (y0 - y2)/(2*den)));
+    }
+
     //offsets to sampling index of header bits
     auto headerSyms = in + firstBit;
     RealType freqCorr = phaseOff + deltaFc*(firstBit);
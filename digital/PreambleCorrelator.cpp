@@ -1,21 +1,61 @@
 // Copyright (c) 2015-2017 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#ifdef POTHOS_XSIMD
+#include "SIMD/DigitalBlocks_SIMD.hpp"
+#endif
+
 #include <Pothos/Framework.hpp>
 #include <cstdint>
 #include <complex>
 #include <cassert>
 #include <iostream>
+#include <vector>
+#include <algorithm>
 
-//provide __popcnt()
+//provide __popcnt() and __popcnt64()
 #ifdef _MSC_VER
 #  include <intrin.h>
 #elif __GNUC__
 #  define __popcnt __builtin_popcount
+#  define __popcnt64 __builtin_popcountll
 #else
 #  error "provide __popcnt() for this compiler"
 #endif
 
+//the longest preamble supported by the packed bits mode
+static const size_t MAX_PACKED_BITS = 256;
+
+//
+// Implementation getters to be called on class construction
+//
+
+using HammingDistanceFcn = void(*)(const std::uint8_t*, const std::uint8_t*, const size_t, unsigned*, const size_t);
+
+#ifdef POTHOS_XSIMD
+
+static HammingDistanceFcn getHammingDistanceFcn()
+{
+    return PothosCommsSIMD::hammingDistanceDispatch<std::uint8_t>();
+}
+
+#else
+
+static HammingDistanceFcn getHammingDistanceFcn()
+{
+    return [](const std::uint8_t *in, const std::uint8_t *preamble, const size_t preambleSize, unsigned *out, const size_t num)
+    {
+        for (size_t n = 0; n < num; n++)
+        {
+            unsigned dist = 0;
+            for (size_t i = 0; i < preambleSize; i++) dist += __popcnt(preamble[i] ^ in[n+i]);
+            out[n] = dist;
+        }
+    };
+}
+
+#endif
+
 /***********************************************************************
  * |PothosDoc Preamble Correlator
  *
@@ -29,6 +69,19 @@
  *
  * http://en.wikipedia.org/wiki/Hamming_distance
  *
+ * The Hamming distance is computed for many positions at once,
+ * with one input position per SIMD lane when XSIMD is available.
+ * When the distance output is enabled, output port 1 produces the Hamming distance at every position,
+ * where distance element n corresponds to the window ending before label index n + preamble size.
+ *
+ * <h2>Packed bits mode</h2>
+ *
+ * When the input is a bit-stream (the least significant bit of each byte),
+ * the packed bits mode shifts every input bit into a register of 64-bit words,
+ * and compares it with the packed preamble using one XOR and popcount per word.
+ * This mode supports preambles of up to 256 bits,
+ * and each preamble symbol must be 0 or 1.
+ *
  * |category /Digital
  * |keywords bit symbol preamble correlate
  * |alias /blocks/preamble_correlator
@@ -44,10 +97,24 @@
  * |default "frameStart"
  * |widget StringEntry()
  *
+ * |param packedBits[Packed Bits] Correlate the input as a bit-stream with packed words.
+ * |default false
+ * |option [Enable] true
+ * |option [Disable] false
+ * |preview disable
+ *
+ * |param distanceOutput[Distance Output] Produce the Hamming distance stream on output port 1.
+ * |default false
+ * |option [Enable] true
+ * |option [Disable] false
+ * |preview disable
+ *
  * |factory /comms/preamble_correlator()
+ * |initializer setDistanceOutput(distanceOutput)
  * |setter setPreamble(preamble)
  * |setter setThreshold(thresh)
  * |setter setFrameStartId(frameStartId)
+ * |setter setPackedBits(packedBits)
  **********************************************************************/
 class PreambleCorrelator : public Pothos::Block
 {
@@ -58,17 +125,23 @@ public:
     }
 
     PreambleCorrelator(void):
-        _threshold(0)
+        _threshold(0),
+        _packedBits(false),
+        _distanceOutput(false),
+        _hammingDistance(getHammingDistanceFcn())
     {
         this->setupInput(0, typeid(unsigned char));
         this->setupOutput(0, typeid(unsigned char), this->uid()); //unique domain because of buffer forwarding
-        //this->setupOutput(1, typeid(unsigned));
         this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, setPreamble));
         this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, getPreamble));
         this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, setThreshold));
         this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, getThreshold));
         this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, setFrameStartId));
         this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, getFrameStartId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, setPackedBits));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, getPackedBits));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, setDistanceOutput));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PreambleCorrelator, getDistanceOutput));
         this->setPreamble(std::vector<unsigned char>(1, 1)); //initial update
         this->setThreshold(1); //initial update
         this->setFrameStartId("frameStart"); //initial update
@@ -77,7 +150,9 @@ public:
     void setPreamble(const std::vector<unsigned char> preamble)
     {
         if (preamble.empty()) throw Pothos::InvalidArgumentException("PreambleCorrelator::setPreamble()", "preamble cannot be empty");
+        if (_packedBits) checkPackedPreamble(preamble);
         _preamble = preamble;
+        this->updatePackedPreamble();
     }
 
     std::vector<unsigned char> getPreamble(void) const
@@ -105,6 +180,28 @@ public:
         return _frameStartId;
     }
 
+    void setPackedBits(const bool packed)
+    {
+        if (packed) checkPackedPreamble(_preamble);
+        _packedBits = packed;
+    }
+
+    bool getPackedBits(void) const
+    {
+        return _packedBits;
+    }
+
+    void setDistanceOutput(const bool enable)
+    {
+        if (enable and this->outputs().size() < 2) this->setupOutput(1, typeid(unsigned));
+        _distanceOutput = enable;
+    }
+
+    bool getDistanceOutput(void) const
+    {
+        return _distanceOutput;
+    }
+
     //! always use a circular buffer to avoid discontinuity over sliding window
     Pothos::BufferManager::Sptr getInputBufferManager(const std::string &, const std::string &)
     {
@@ -115,7 +212,6 @@ public:
     {
         auto inputPort = this->input(0);
         auto outputPort = this->output(0);
-        //auto outputDistance = this->output(1);
 
         //require preamble size + 1 elements to perform processing
         inputPort->setReserve(_preamble.size()+1);
@@ -125,38 +221,111 @@ public:
         //due to search window, the last preamble size elements are used
         //consume and forward all processable elements of the input buffer
         buffer.length -= _preamble.size();
+
+        //the distance output limits the number of positions per call
+        unsigned *distance = nullptr;
+        if (_distanceOutput)
+        {
+            auto outputDistance = this->output(1);
+            buffer.length = std::min(buffer.length, outputDistance->elements());
+            if (buffer.length == 0) return;
+            distance = outputDistance->buffer().as<unsigned *>();
+        }
+        else
+        {
+            if (_distance.size() < buffer.length) _distance.resize(buffer.length);
+            distance = _distance.data();
+        }
         inputPort->consume(buffer.length);
 
         // Calculate Hamming distance at each position looking for match
+        const unsigned char *in = buffer;
+        if (not _packedBits) _hammingDistance(in, _preamble.data(), _preamble.size(), distance, buffer.length);
+        else switch (_packedPreamble.size())
+        {
+        case 1: this->packedDistance<1>(in, distance, buffer.length); break;
+        case 2: this->packedDistance<2>(in, distance, buffer.length); break;
+        case 3: this->packedDistance<3>(in, distance, buffer.length); break;
+        default: this->packedDistance<4>(in, distance, buffer.length); break;
+        }
+
         // When a match is found a label is created after the preamble
-        unsigned char *in = buffer;
-        //auto distance = outputDistance->buffer().template as<unsigned *>();
         for (size_t n = 0; n < buffer.length; n++)
         {
-            unsigned dist = 0;
-
-            // Count the number of bits set
-            for (size_t i = 0; i < _preamble.size(); i++)
-            {
-                // A bit is set, so increment the distance
-                dist += __popcnt(_preamble[i] ^ in[n+i]);
-            }
-            // Emit a label if within the distance threshold
-            if (dist <= _threshold)
+            if (distance[n] <= _threshold)
             {
                 outputPort->postLabel(_frameStartId, Pothos::Object(), n + _preamble.size());
             }
-
-            //distance[n] = dist;
         }
-        //outputDistance->produce(N);
+
+        if (_distanceOutput) this->output(1)->produce(buffer.length);
         outputPort->postBuffer(std::move(buffer));
     }
 
 private:
+
+    static void checkPackedPreamble(const std::vector<unsigned char> &preamble)
+    {
+        if (preamble.size() > MAX_PACKED_BITS) throw Pothos::InvalidArgumentException("PreambleCorrelator::setPackedBits()", "preamble too long for packed bits");
+        for (const auto bit : preamble)
+        {
+            if (bit > 1) throw Pothos::InvalidArgumentException("PreambleCorrelator::setPackedBits()", "preamble symbols must be bits");
+        }
+    }
+
+    //pack the preamble so that bit j of the register is the preamble symbol j from the end
+    void updatePackedPreamble(void)
+    {
+        const size_t numBits = std::min(_preamble.size(), MAX_PACKED_BITS);
+        _packedPreamble.assign((numBits+63)/64, 0);
+        _packedMask.assign(_packedPreamble.size(), ~uint64_t(0));
+        for (size_t j = 0; j < numBits; j++)
+        {
+            if ((_preamble[_preamble.size()-1-j] & 1) != 0) _packedPreamble[j/64] |= uint64_t(1) << (j%64);
+        }
+        if ((numBits%64) != 0) _packedMask.back() = (uint64_t(1) << (numBits%64))-1;
+    }
+
+    /*!
+     * Packed bits distance over num positions:
+     * The register holds the last preamble size input bits,
+     * with the newest bit in the least significant bit of the first word.
+     */
+    template <size_t NumWords>
+    void packedDistance(const unsigned char *in, unsigned *distance, const size_t num)
+    {
+        const size_t P = _preamble.size();
+        uint64_t reg[NumWords] = {};
+        const auto shiftIn = [&reg](const unsigned char bit)
+        {
+            for (size_t w = NumWords-1; w > 0; w--) reg[w] = (reg[w] << 1) | (reg[w-1] >> 63);
+            reg[0] = (reg[0] << 1) | (bit & 1);
+        };
+
+        //the first window is missing its last bit
+        for (size_t i = 0; i+1 < P; i++) shiftIn(in[i]);
+
+        for (size_t n = 0; n < num; n++)
+        {
+            shiftIn(in[n+P-1]);
+            unsigned dist = 0;
+            for (size_t w = 0; w < NumWords; w++)
+            {
+                dist += unsigned(__popcnt64((reg[w] ^ _packedPreamble[w]) & _packedMask[w]));
+            }
+            distance[n] = dist;
+        }
+    }
+
     unsigned _threshold;
     std::string _frameStartId;
     std::vector<unsigned char> _preamble;
+    bool _packedBits;
+    std::vector<uint64_t> _packedPreamble;
+    std::vector<uint64_t> _packedMask;
+    bool _distanceOutput;
+    HammingDistanceFcn _hammingDistance;
+    std::vector<unsigned> _distance;
 };
 
 /***********************************************************************
@@ -0,0 +1,101 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <xsimd/xsimd.hpp>
+#include <Pothos/Util/XSIMDTraits.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+// Actually enforce EnableIfXSIMDSupports
+#ifdef _MSC_VER
+#pragma warning(error: 4667) // no function template defined that matches forced instantiation
+#endif
+
+#if !defined POTHOS_SIMD_NAMESPACE
+#error Must define POTHOS_SIMD_NAMESPACE to build this file
+#endif
+
+namespace PothosCommsSIMD { namespace POTHOS_SIMD_NAMESPACE {
+
+namespace detail
+{
+    //the most preamble symbols whose byte distances fit in a byte accumulator
+    static const size_t MAX_BYTE_ACCUM_SYMBOLS = 31;
+
+    /*******************************************************************
+     * out[n] = sum of popcount(preamble[i] ^ in[n+i]) over the preamble,
+     * evaluated for num consecutive positions
+     ******************************************************************/
+    template <typename T>
+    static void hammingDistanceUnoptimized(const T *in, const T *preamble, const size_t preambleSize, unsigned *out, const size_t num)
+    {
+        for (size_t n = 0; n < num; n++)
+        {
+            unsigned dist = 0;
+            for (size_t i = 0; i < preambleSize; i++)
+            {
+                T x = preamble[i] ^ in[n+i];
+                for (; x != 0; x &= T(x-1)) dist++;
+            }
+            out[n] = dist;
+        }
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDSupports<T, void> hammingDistance(const T *in, const T *preamble, const size_t preambleSize, unsigned *out, const size_t num)
+    {
+        static constexpr size_t simdSize = xsimd::simd_traits<T>::size;
+        const size_t numSIMDFrames = num / simdSize;
+        const auto m1 = xsimd::batch<T, simdSize>(T(0x55));
+        const auto m2 = xsimd::batch<T, simdSize>(T(0x33));
+        const auto m4 = xsimd::batch<T, simdSize>(T(0x0f));
+        T partial[simdSize];
+
+        //each lane is one position, and the per-byte popcounts are
+        //accumulated in bytes over blocks of preamble symbols
+        for (size_t n = 0; n < numSIMDFrames*simdSize; n += simdSize)
+        {
+            for (size_t k = 0; k < simdSize; k++) out[n+k] = 0;
+            for (size_t i0 = 0; i0 < preambleSize; i0 += MAX_BYTE_ACCUM_SYMBOLS)
+            {
+                const size_t i1 = std::min(preambleSize, i0+MAX_BYTE_ACCUM_SYMBOLS);
+                auto acc = xsimd::batch<T, simdSize>(T(0));
+                for (size_t i = i0; i < i1; i++)
+                {
+                    auto x = xsimd::load_unaligned(in+n+i) ^ xsimd::batch<T, simdSize>(preamble[i]);
+                    x = x - ((x >> 1) & m1);
+                    x = (x & m2) + ((x >> 2) & m2);
+                    acc += (x + (x >> 4)) & m4;
+                }
+                acc.store_unaligned(partial);
+                for (size_t k = 0; k < simdSize; k++) out[n+k] += partial[k];
+            }
+        }
+
+        const size_t tail = numSIMDFrames*simdSize;
+        hammingDistanceUnoptimized(in+tail, preamble, preambleSize, out+tail, num-tail);
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDDoesNotSupport<T, void> hammingDistance(const T *in, const T *preamble, const size_t preambleSize, unsigned *out, const size_t num)
+    {
+        hammingDistanceUnoptimized(in, preamble, preambleSize, out, num);
+    }
+}
+
+// Hide the SFINAE
+template <typename T>
+void hammingDistance(const T *in, const T *preamble, const size_t preambleSize, unsigned *out, const size_t num)
+{
+    detail::hammingDistance(in, preamble, preambleSize, out, num);
+}
+
+#define HAMMING_DISTANCE(T) \
+    template void hammingDistance(const T*, const T*, size_t, unsigned*, size_t);
+
+    HAMMING_DISTANCE(std::uint8_t)
+
+}}
@@ -0,0 +1,124 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <xsimd/xsimd.hpp>
+#include <Pothos/Util/XSIMDTraits.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+// Actually enforce EnableIfXSIMDSupports
+#ifdef _MSC_VER
+#pragma warning(error: 4667) // no function template defined that matches forced instantiation
+#endif
+
+#if !defined POTHOS_SIMD_NAMESPACE
+#error Must define POTHOS_SIMD_NAMESPACE to build this file
+#endif
+
+namespace PothosCommsSIMD { namespace POTHOS_SIMD_NAMESPACE {
+
+namespace detail
+{
+    /*******************************************************************
+     * out[n] = in[n*stride]*p[n] with the recursive phasor p[n+1] = p[n]*step,
+     * input and output interleaved complex, phasor and step as [re, im],
+     * the phasor is updated to the value after the last output
+     ******************************************************************/
+    template <typename T>
+    static void phasorMultiplyUnoptimized(const T *in, const size_t stride, T *phasor, const T *step, T *out, const size_t num)
+    {
+        T pr = phasor[0], pi = phasor[1];
+        for (size_t n = 0; n < num; n++)
+        {
+            const T xr = in[2*n*stride+0], xi = in[2*n*stride+1];
+            out[2*n+0] = xr*pr - xi*pi;
+            out[2*n+1] = xr*pi + xi*pr;
+            const T r = pr*step[0] - pi*step[1];
+            pi = pr*step[1] + pi*step[0];
+            pr = r;
+        }
+        phasor[0] = pr;
+        phasor[1] = pi;
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDSupports<T, void> phasorMultiply(const T *in, const size_t stride, T *phasor, const T *step, T *out, const size_t num)
+    {
+        static constexpr size_t simdSize = xsimd::simd_traits<T>::size;
+        const size_t numSIMDFrames = num / simdSize;
+        T xr[simdSize], xi[simdSize], yr[simdSize], yi[simdSize];
+
+        //each lane holds the phasor of one output in the frame,
+        //and every lane advances by the step to the power of simdSize
+        T pr = phasor[0], pi = phasor[1], sr = 1, si = 0;
+        for (size_t k = 0; k < simdSize; k++)
+        {
+            yr[k] = pr;
+            yi[k] = pi;
+            T r = pr*step[0] - pi*step[1];
+            pi = pr*step[1] + pi*step[0];
+            pr = r;
+            r = sr*step[0] - si*step[1];
+            si = sr*step[1] + si*step[0];
+            sr = r;
+        }
+        auto ar = xsimd::load_unaligned(yr);
+        auto ai = xsimd::load_unaligned(yi);
+        const auto br = xsimd::batch<T, simdSize>(sr);
+        const auto bi = xsimd::batch<T, simdSize>(si);
+
+        for (size_t i = 0; i < numSIMDFrames*simdSize; i += simdSize)
+        {
+            //the input is strided in the timing mode, so gather the frame
+            for (size_t k = 0; k < simdSize; k++)
+            {
+                xr[k] = in[2*(i+k)*stride+0];
+                xi[k] = in[2*(i+k)*stride+1];
+            }
+            const auto cr = xsimd::load_unaligned(xr);
+            const auto ci = xsimd::load_unaligned(xi);
+            (cr*ar - ci*ai).store_unaligned(yr);
+            (cr*ai + ci*ar).store_unaligned(yi);
+            for (size_t k = 0; k < simdSize; k++)
+            {
+                out[2*(i+k)+0] = yr[k];
+                out[2*(i+k)+1] = yi[k];
+            }
+
+            const auto r = ar*br - ai*bi;
+            ai = ar*bi + ai*br;
+            ar = r;
+        }
+
+        //the first lane holds the phasor of the first output after the frames
+        ar.store_unaligned(yr);
+        ai.store_unaligned(yi);
+        phasor[0] = yr[0];
+        phasor[1] = yi[0];
+
+        const size_t tail = numSIMDFrames*simdSize;
+        phasorMultiplyUnoptimized(in+2*tail*stride, stride, phasor, step, out+2*tail, num-tail);
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDDoesNotSupport<T, void> phasorMultiply(const T *in, const size_t stride, T *phasor, const T *step, T *out, const size_t num)
+    {
+        phasorMultiplyUnoptimized(in, stride, phasor, step, out, num);
+    }
+}
+
+// Hide the SFINAE
+template <typename T>
+void phasorMultiply(const T *in, const size_t stride, T *phasor, const T *step, T *out, const size_t num)
+{
+    detail::phasorMultiply(in, stride, phasor, step, out, num);
+}
+
+#define PHASOR_MULTIPLY(T) \
+    template void phasorMultiply(const T*, size_t, T*, const T*, T*, size_t);
+
+    PHASOR_MULTIPLY(float)
+    PHASOR_MULTIPLY(double)
+
+}}
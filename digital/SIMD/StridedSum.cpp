@@ -0,0 +1,78 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <xsimd/xsimd.hpp>
+#include <Pothos/Util/XSIMDTraits.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+// Actually enforce EnableIfXSIMDSupports
+#ifdef _MSC_VER
+#pragma warning(error: 4667) // no function template defined that matches forced instantiation
+#endif
+
+#if !defined POTHOS_SIMD_NAMESPACE
+#error Must define POTHOS_SIMD_NAMESPACE to build this file
+#endif
+
+namespace PothosCommsSIMD { namespace POTHOS_SIMD_NAMESPACE {
+
+namespace detail
+{
+    /*******************************************************************
+     * out[i] = sum of coeffs[t]*in[i + t*stride] over numCoeffs taps,
+     * evaluated for num consecutive outputs
+     ******************************************************************/
+    template <typename T>
+    static void stridedWeightedSumUnoptimized(const T *in, const T *coeffs, const size_t numCoeffs, const size_t stride, T *out, const size_t num)
+    {
+        for (size_t i = 0; i < num; i++)
+        {
+            T acc = 0;
+            for (size_t t = 0; t < numCoeffs; t++) acc += coeffs[t]*in[i+t*stride];
+            out[i] = acc;
+        }
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDSupports<T, void> stridedWeightedSum(const T *in, const T *coeffs, const size_t numCoeffs, const size_t stride, T *out, const size_t num)
+    {
+        static constexpr size_t simdSize = xsimd::simd_traits<T>::size;
+        const size_t numSIMDFrames = num / simdSize;
+
+        for (size_t i = 0; i < numSIMDFrames*simdSize; i += simdSize)
+        {
+            auto acc = xsimd::batch<T, simdSize>(T(0));
+            for (size_t t = 0; t < numCoeffs; t++)
+            {
+                acc += xsimd::batch<T, simdSize>(coeffs[t])*xsimd::load_unaligned(in+i+t*stride);
+            }
+            acc.store_unaligned(out+i);
+        }
+
+        const size_t tail = numSIMDFrames*simdSize;
+        stridedWeightedSumUnoptimized(in+tail, coeffs, numCoeffs, stride, out+tail, num-tail);
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDDoesNotSupport<T, void> stridedWeightedSum(const T *in, const T *coeffs, const size_t numCoeffs, const size_t stride, T *out, const size_t num)
+    {
+        stridedWeightedSumUnoptimized(in, coeffs, numCoeffs, stride, out, num);
+    }
+}
+
+// Hide the SFINAE
+template <typename T>
+void stridedWeightedSum(const T *in, const T *coeffs, const size_t numCoeffs, const size_t stride, T *out, const size_t num)
+{
+    detail::stridedWeightedSum(in, coeffs, numCoeffs, stride, out, num);
+}
+
+#define STRIDED_WEIGHTED_SUM(T) \
+    template void stridedWeightedSum(const T*, const T*, size_t, size_t, T*, size_t);
+
+    STRIDED_WEIGHTED_SUM(float)
+    STRIDED_WEIGHTED_SUM(double)
+
+}}
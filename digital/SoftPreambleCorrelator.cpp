@@ -0,0 +1,314 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#ifdef POTHOS_XSIMD
+#include "SIMD/DigitalBlocks_SIMD.hpp"
+#endif
+
+#include <Pothos/Framework.hpp>
+#include <algorithm> //min/max
+#include <complex>
+#include <cstdint>
+#include <vector>
+#include <cmath>
+
+//
+// Implementation getters to be called on class construction
+//
+
+template <typename Type>
+using StridedWeightedSumFcn = void(*)(const Type*, const Type*, const size_t, const size_t, Type*, const size_t);
+
+#ifdef POTHOS_XSIMD
+
+template <typename Type>
+static StridedWeightedSumFcn<Type> getStridedWeightedSumFcn()
+{
+    return PothosCommsSIMD::stridedWeightedSumDispatch<Type>();
+}
+
+#else
+
+template <typename Type>
+static StridedWeightedSumFcn<Type> getStridedWeightedSumFcn()
+{
+    return [](const Type *in, const Type *coeffs, const size_t numCoeffs, const size_t stride, Type *out, const size_t num)
+    {
+        for (size_t i = 0; i < num; i++)
+        {
+            Type acc = 0;
+            for (size_t t = 0; t < numCoeffs; t++) acc += coeffs[t]*in[i+t*stride];
+            out[i] = acc;
+        }
+    };
+}
+
+#endif
+
+/***********************************************************************
+ * |PothosDoc Soft Preamble Correlator
+ *
+ * The Soft Preamble Correlator searches an input stream of soft symbols on port 0
+ * for a matching preamble and forwards the stream to output port 0
+ * with a label annotating the first symbol after the preamble match.
+ * Unlike the hard-decision preamble correlator, the input does not need
+ * to be sliced into symbols before the search.
+ *
+ * <h2>Normalized correlation</h2>
+ *
+ * At each input position, the correlation of the window of preamble size symbols
+ * with the conjugate preamble is normalized by the preamble energy and a running
+ * energy of the input window, so that the correlation is between 0 and 1
+ * regardless of the input amplitude and carrier phase:
+ *
+ * rho[n] = |sum(conj(p[i])*x[n+i])| / sqrt(sum(|p[i]|^2)*sum(|x[n+i]|^2))
+ *
+ * The correlation sums are computed with SIMD for many positions at once.
+ *
+ * <h2>Peak detection</h2>
+ *
+ * A label is produced at the largest correlation that exceeds the threshold,
+ * after the correlation falls below the threshold,
+ * or when no larger correlation follows within one preamble length.
+ * The label data is the normalized correlation of the peak.
+ *
+ * |category /Digital
+ * |keywords soft symbol preamble correlate normalized
+ *
+ * |param dtype[Data Type] The input data type of the soft symbols.
+ * |widget DTypeChooser(float=1,cfloat=1)
+ * |default "complex_float32"
+ * |preview disable
+ *
+ * |param preamble A vector of symbols representing the preamble.
+ * |default [1, 1, 1, -1, 1]
+ * |option [Barker Code 5] \[1, 1, 1, -1, 1\]
+ * |option [Barker Code 7] \[1, 1, 1, -1, -1, 1, -1\]
+ * |option [Barker Code 11] \[1, 1, 1, -1, -1, -1, 1, -1, -1, 1, -1\]
+ * |option [Barker Code 13] \[1, 1, 1, 1, 1, -1, -1, 1, 1, -1, 1, -1, 1\]
+ *
+ * |param thresh[Threshold] The normalized correlation threshold for preamble match detection.
+ * |default 0.8
+ *
+ * |param frameStartId[Frame Start ID] The label ID that marks the first symbol of a correlator match.
+ * |default "frameStart"
+ * |widget StringEntry()
+ *
+ * |factory /comms/soft_preamble_correlator(dtype)
+ * |setter setPreamble(preamble)
+ * |setter setThreshold(thresh)
+ * |setter setFrameStartId(frameStartId)
+ **********************************************************************/
+template <typename Type, typename RealType>
+class SoftPreambleCorrelator : public Pothos::Block
+{
+public:
+    SoftPreambleCorrelator(void):
+        _threshold(0.8),
+        _preambleEnergy(0),
+        _stridedWeightedSum(getStridedWeightedSumFcn<RealType>()),
+        _peakActive(false),
+        _peakValue(0),
+        _peakPosition(0)
+    {
+        this->setupInput(0, typeid(Type));
+        this->setupOutput(0, typeid(Type), this->uid()); //unique domain because of buffer forwarding
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftPreambleCorrelator, setPreamble));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftPreambleCorrelator, getPreamble));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftPreambleCorrelator, setThreshold));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftPreambleCorrelator, getThreshold));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftPreambleCorrelator, setFrameStartId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SoftPreambleCorrelator, getFrameStartId));
+        this->setPreamble(std::vector<Type>({1, 1, 1, -1, 1})); //initial update
+        this->setThreshold(0.8); //initial update
+        this->setFrameStartId("frameStart"); //initial update
+    }
+
+    void setPreamble(const std::vector<Type> preamble)
+    {
+        if (preamble.empty()) throw Pothos::InvalidArgumentException("SoftPreambleCorrelator::setPreamble()", "preamble cannot be empty");
+        double energy = 0;
+        for (const auto &p : preamble) energy += std::norm(p);
+        if (energy == 0) throw Pothos::InvalidArgumentException("SoftPreambleCorrelator::setPreamble()", "preamble cannot be all zeros");
+        _preamble = preamble;
+        _preambleEnergy = energy;
+
+        //split the conjugate preamble into real coefficients for the strided sums
+        _preambleRe.resize(preamble.size());
+        _preambleIm.resize(preamble.size());
+        for (size_t i = 0; i < preamble.size(); i++)
+        {
+            _preambleRe[i] = RealType(std::real(preamble[i]));
+            _preambleIm[i] = RealType(std::imag(preamble[i]));
+        }
+        _preambleIsReal = std::all_of(_preambleIm.begin(), _preambleIm.end(), [](const RealType x){return x == 0;});
+        _peakActive = false;
+    }
+
+    std::vector<Type> getPreamble(void) const
+    {
+        return _preamble;
+    }
+
+    void setThreshold(const double threshold)
+    {
+        if (threshold <= 0 or threshold > 1) throw Pothos::RangeException("SoftPreambleCorrelator::setThreshold()", "threshold must be in (0, 1]");
+        _threshold = threshold;
+    }
+
+    double getThreshold(void) const
+    {
+        return _threshold;
+    }
+
+    void setFrameStartId(std::string id)
+    {
+        _frameStartId = id;
+    }
+
+    std::string getFrameStartId(void) const
+    {
+        return _frameStartId;
+    }
+
+    //! always use a circular buffer to avoid discontinuity over sliding window
+    Pothos::BufferManager::Sptr getInputBufferManager(const std::string &, const std::string &)
+    {
+        return Pothos::BufferManager::make("circular");
+    }
+
+    void activate(void)
+    {
+        _peakActive = false;
+    }
+
+    void work(void)
+    {
+        auto inputPort = this->input(0);
+        auto outputPort = this->output(0);
+        const size_t P = _preamble.size();
+
+        //require preamble size + 1 elements to perform processing
+        inputPort->setReserve(P+1);
+        auto buffer = inputPort->takeBuffer();
+        if (buffer.length <= P) return;
+
+        //due to search window, the last preamble size elements are used
+        //consume and forward all processable elements of the input buffer
+        const unsigned long long start = inputPort->totalElements();
+        buffer.length -= P;
+        const size_t N = buffer.length;
+        inputPort->consume(N);
+
+        const Type *in = buffer;
+        this->correlate(in, N);
+
+        //running energy of the input window, evaluated exactly on every call
+        double energy = 0;
+        for (size_t i = 0; i < P; i++) energy += std::norm(in[i]);
+
+        for (size_t n = 0; n < N; n++)
+        {
+            const double corr = double(_corrRe[n])*_corrRe[n] + double(_corrIm[n])*_corrIm[n];
+            const double rho = (energy > 0)?std::min(1.0, std::sqrt(corr/(_preambleEnergy*energy))):0.0;
+            energy = std::max(0.0, energy + std::norm(in[n+P]) - std::norm(in[n]));
+
+            //no larger correlation within one preamble length
+            const unsigned long long position = start + n;
+            if (_peakActive and position - _peakPosition >= P) this->postPeak(start);
+
+            if (rho >= _threshold)
+            {
+                if (not _peakActive or rho > _peakValue)
+                {
+                    _peakActive = true;
+                    _peakValue = rho;
+                    _peakPosition = position;
+                }
+            }
+            else if (_peakActive) this->postPeak(start);
+        }
+
+        outputPort->postBuffer(std::move(buffer));
+    }
+
+private:
+
+    //label the first symbol after the preamble of the peak
+    void postPeak(const unsigned long long start)
+    {
+        this->output(0)->postLabel(_frameStartId, RealType(_peakValue), size_t(_peakPosition + _preamble.size() - start));
+        _peakActive = false;
+    }
+
+    //correlation of the conjugate preamble with num windows of real input
+    void correlate(const RealType *in, const size_t num)
+    {
+        _corrRe.resize(num);
+        _corrIm.assign(num, 0);
+        _stridedWeightedSum(in, _preambleRe.data(), _preambleRe.size(), 1, _corrRe.data(), num);
+    }
+
+    //correlation of the conjugate preamble with num windows of complex input:
+    //re = sum(pr*xr + pi*xi), im = sum(pr*xi - pi*xr)
+    void correlate(const std::complex<RealType> *in, const size_t num)
+    {
+        const size_t P = _preamble.size();
+        _inRe.resize(num+P-1);
+        _inIm.resize(num+P-1);
+        for (size_t i = 0; i < num+P-1; i++)
+        {
+            _inRe[i] = in[i].real();
+            _inIm[i] = in[i].imag();
+        }
+
+        _corrRe.resize(num);
+        _corrIm.resize(num);
+        _stridedWeightedSum(_inRe.data(), _preambleRe.data(), P, 1, _corrRe.data(), num);
+        _stridedWeightedSum(_inIm.data(), _preambleRe.data(), P, 1, _corrIm.data(), num);
+        if (_preambleIsReal) return;
+
+        _scratch.resize(num);
+        _stridedWeightedSum(_inIm.data(), _preambleIm.data(), P, 1, _scratch.data(), num);
+        for (size_t n = 0; n < num; n++) _corrRe[n] += _scratch[n];
+        _stridedWeightedSum(_inRe.data(), _preambleIm.data(), P, 1, _scratch.data(), num);
+        for (size_t n = 0; n < num; n++) _corrIm[n] -= _scratch[n];
+    }
+
+    double _threshold;
+    std::string _frameStartId;
+    std::vector<Type> _preamble;
+    double _preambleEnergy;
+    std::vector<RealType> _preambleRe;
+    std::vector<RealType> _preambleIm;
+    bool _preambleIsReal;
+    StridedWeightedSumFcn<RealType> _stridedWeightedSum;
+
+    //scratch buffers for the correlation sums
+    std::vector<RealType> _inRe, _inIm;
+    std::vector<RealType> _corrRe, _corrIm;
+    std::vector<RealType> _scratch;
+
+    //the peak that is being tracked above the threshold
+    bool _peakActive;
+    double _peakValue;
+    unsigned long long _peakPosition;
+};
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *softPreambleCorrelatorFactory(const Pothos::DType &dtype)
+{
+    #define ifTypeDeclareFactory(type) \
+        if (dtype == Pothos::DType(typeid(type))) \
+            return new SoftPreambleCorrelator<type, type>(); \
+        if (dtype == Pothos::DType(typeid(std::complex<type>))) \
+            return new SoftPreambleCorrelator<std::complex<type>, type>();
+    ifTypeDeclareFactory(double);
+    ifTypeDeclareFactory(float);
+    throw Pothos::InvalidArgumentException("softPreambleCorrelatorFactory("+dtype.toString()+")", "unsupported type");
+}
+
+static Pothos::BlockRegistry registerSoftPreambleCorrelator(
+    "/comms/soft_preamble_correlator", &softPreambleCorrelatorFactory);
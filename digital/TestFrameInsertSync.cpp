@@ -0,0 +1,426 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <complex>
+#include <cstdlib>
+#include <random>
+#include <cmath>
+
+typedef std::complex<float> Type;
+static const size_t symbolWidth = 20;
+static const size_t dataWidth = 4;
+
+/***********************************************************************
+ * Random QPSK payload of the given length
+ **********************************************************************/
+static Pothos::BufferChunk randomPayload(const size_t length)
+{
+    Pothos::BufferChunk payload(typeid(Type), length);
+    auto p = payload.as<Type *>();
+    for (size_t i = 0; i < length; i++)
+    {
+        p[i] = Type((std::rand() & 1)?1.0f:-1.0f, (std::rand() & 1)?1.0f:-1.0f);
+    }
+    return payload;
+}
+
+/***********************************************************************
+ * The waveform of framed payloads with a rectangular pulse per symbol
+ **********************************************************************/
+static Pothos::BufferChunk insertFrames(
+    const std::vector<Type> &preamble,
+    const unsigned char headerId,
+    const std::vector<Pothos::BufferChunk> &payloads)
+{
+    const auto dtype = Pothos::DType(typeid(Type));
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+    auto generator = Pothos::BlockRegistry::make("/blocks/packet_to_stream");
+    auto inserter = Pothos::BlockRegistry::make("/comms/frame_insert", dtype);
+    auto pulse = Pothos::BlockRegistry::make("/comms/fir_filter", dtype, "REAL");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+
+    generator.call("setFrameStartId", "txFrameStart");
+    generator.call("setFrameEndId", "txFrameEnd");
+    inserter.call("setPreamble", preamble);
+    inserter.call("setHeaderId", headerId);
+    inserter.call("setSymbolWidth", symbolWidth);
+    inserter.call("setFrameStartId", "txFrameStart");
+    inserter.call("setFrameEndId", "txFrameEnd");
+    inserter.call("setPaddingSize", 300);
+    pulse.call("setInterpolation", dataWidth);
+    pulse.call("setTaps", std::vector<double>(dataWidth, 1.0));
+
+    for (const auto &payload : payloads)
+    {
+        Pothos::Packet packet;
+        packet.payload = payload;
+        feeder.call("feedPacket", packet);
+    }
+
+    Pothos::Topology topology;
+    topology.connect(feeder, 0, generator, 0);
+    topology.connect(generator, 0, inserter, 0);
+    topology.connect(inserter, 0, pulse, 0);
+    topology.connect(pulse, 0, collector, 0);
+    topology.commit();
+    POTHOS_TEST_TRUE(topology.waitInactive());
+    return collector.call("getBuffer");
+}
+
+/***********************************************************************
+ * Feed the waveform to the frame sync and collect the output
+ **********************************************************************/
+static Pothos::Proxy collectSync(const Pothos::Proxy &sync, const Pothos::BufferChunk &waveform)
+{
+    const auto dtype = Pothos::DType(typeid(Type));
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+    auto copier = Pothos::BlockRegistry::make("/blocks/copier");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+    feeder.call("feedBuffer", waveform);
+
+    Pothos::Topology topology;
+    topology.connect(feeder, 0, copier, 0);
+    topology.connect(copier, 0, sync, 0);
+    topology.connect(sync, 0, collector, 0);
+    topology.commit();
+    POTHOS_TEST_TRUE(topology.waitInactive());
+    return collector;
+}
+
+static void testFrameInsertToSync(const size_t numThreads, const std::vector<size_t> &lengths)
+{
+    std::cout << "Testing frame insert to sync with " << numThreads << " search threads" << std::endl;
+
+    const auto dtype = Pothos::DType(typeid(Type));
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+    auto generator = Pothos::BlockRegistry::make("/blocks/packet_to_stream");
+    auto inserter = Pothos::BlockRegistry::make("/comms/frame_insert", dtype);
+    auto pulse = Pothos::BlockRegistry::make("/comms/fir_filter", dtype, "REAL");
+    auto sync = Pothos::BlockRegistry::make("/comms/frame_sync", dtype);
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+
+    //Copy block provides the loopback path:
+    //Copy can cause buffer boundaries to change,
+    //which helps to aid in robust testing.
+    auto copier = Pothos::BlockRegistry::make("/blocks/copier");
+
+    //configuration constants
+    const std::vector<Type> preamble = {1, 1, 1, -1, 1};
+
+    //configure
+    generator.call("setFrameStartId", "txFrameStart");
+    generator.call("setFrameEndId", "txFrameEnd");
+    inserter.call("setPreamble", preamble);
+    inserter.call("setSymbolWidth", symbolWidth);
+    inserter.call("setFrameStartId", "txFrameStart");
+    inserter.call("setFrameEndId", "txFrameEnd");
+    inserter.call("setPaddingSize", 300); //flushes the search window after every frame
+    pulse.call("setInterpolation", dataWidth);
+    pulse.call("setTaps", std::vector<double>(dataWidth, 1.0)); //rectangular pulse per symbol
+    sync.call("setPreamble", preamble);
+    sync.call("setSymbolWidth", symbolWidth);
+    sync.call("setDataWidth", dataWidth);
+    sync.call("setOutputMode", "TIMING");
+    sync.call("setFrameStartId", "rxFrameStart");
+    sync.call("setFrameEndId", "rxFrameEnd");
+    sync.call("setNumThreads", numThreads);
+
+    //random QPSK payloads
+    std::vector<Type> expected;
+    for (const auto length : lengths)
+    {
+        Pothos::Packet packet;
+        packet.payload = randomPayload(length);
+        auto p = packet.payload.as<const Type *>();
+        expected.insert(expected.end(), p, p+length);
+        feeder.call("feedPacket", packet);
+    }
+
+    //create tester topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, generator, 0);
+        topology.connect(generator, 0, inserter, 0);
+        topology.connect(inserter, 0, copier, 0);
+        topology.connect(copier, 0, pulse, 0);
+        topology.connect(pulse, 0, sync, 0);
+        topology.connect(sync, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //every payload is forwarded
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(buff.elements(), expected.size());
+    auto out = buff.as<const Type *>();
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        POTHOS_TEST_TRUE(std::abs(out[i]-expected[i]) < 1e-3);
+    }
+
+    //with start labels that carry the length, and end labels
+    std::vector<Pothos::Label> labels = collector.call("getLabels");
+    size_t index = 0, frameNo = 0;
+    for (const auto &label : labels)
+    {
+        if (label.id == "rxFrameStart")
+        {
+            POTHOS_TEST_TRUE(frameNo < lengths.size());
+            POTHOS_TEST_EQUAL(label.index, index);
+            POTHOS_TEST_EQUAL(label.data.convert<size_t>(), lengths[frameNo]);
+        }
+        if (label.id == "rxFrameEnd")
+        {
+            index += lengths[frameNo++];
+            POTHOS_TEST_EQUAL(label.index, index-1);
+        }
+    }
+    POTHOS_TEST_EQUAL(frameNo, lengths.size());
+
+    //the statistics account for every frame
+    POTHOS_TEST_EQUAL(sync.call<unsigned long long>("getAcceptedFrames"), lengths.size());
+    POTHOS_TEST_TRUE(sync.call<unsigned long long>("getFramesDetected") >= lengths.size());
+    POTHOS_TEST_TRUE(sync.call<unsigned long long>("getSamplesSearched") > 0);
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_frame_insert_to_sync)
+{
+    const std::vector<size_t> lengths = {100, 237, 64, 512};
+    testFrameInsertToSync(1, lengths);
+    testFrameInsertToSync(4, lengths);
+}
+
+/***********************************************************************
+ * The frame inserter caches the encoded headers by payload length:
+ * Repeat lengths that are cached, and lengths that were evicted
+ * after more than the 16 cached lengths, every header still decodes.
+ **********************************************************************/
+POTHOS_TEST_BLOCK("/comms/tests", test_frame_insert_header_cache)
+{
+    std::vector<size_t> lengths;
+    for (size_t i = 0; i < 20; i++) lengths.push_back(30+7*i);
+    lengths.push_back(lengths.back()); //most recently used
+    lengths.push_back(lengths[10]); //still cached
+    lengths.push_back(lengths[0]); //evicted
+    lengths.push_back(lengths[1]); //evicted
+    lengths.push_back(lengths[0]); //cached again
+    testFrameInsertToSync(1, lengths);
+}
+
+
+/***********************************************************************
+ * Compare the bounded frame search with the full computation at every
+ * offset over noisy frames, with the input threshold near the signal level
+ **********************************************************************/
+POTHOS_TEST_BLOCK("/comms/tests", test_frame_sync_search_bounds)
+{
+    const auto dtype = Pothos::DType(typeid(Type));
+    const std::vector<Type> preamble = {1, 1, 1, -1, 1};
+
+    //add noise so that the correlation peaks are near the threshold
+    std::vector<Pothos::BufferChunk> payloads;
+    for (size_t frameNo = 0; frameNo < 16; frameNo++) payloads.push_back(randomPayload(50+(std::rand() % 200)));
+    const auto frames = insertFrames(preamble, 0x55, payloads);
+    std::mt19937 rng(42);
+    std::normal_distribution<float> noise(0.0f, 0.35f);
+    Pothos::BufferChunk noisy(dtype, frames.elements());
+    for (size_t i = 0; i < frames.elements(); i++)
+    {
+        noisy.as<Type *>()[i] = frames.as<const Type *>()[i] + Type(noise(rng), noise(rng));
+    }
+
+    //search with and without the bounds
+    std::vector<Pothos::Proxy> syncs, collectors;
+    for (const bool searchBounds : {true, false})
+    {
+        auto sync = Pothos::BlockRegistry::make("/comms/frame_sync", dtype);
+        sync.call("setPreamble", preamble);
+        sync.call("setSymbolWidth", symbolWidth);
+        sync.call("setDataWidth", dataWidth);
+        sync.call("setOutputMode", "RAW");
+        sync.call("setInputThreshold", 0.8);
+        sync.call("setSearchBounds", searchBounds);
+        syncs.push_back(sync);
+        collectors.push_back(collectSync(sync, noisy));
+    }
+
+    //the same frames are found at the same indexes
+    std::vector<Pothos::Label> bounded = collectors[0].call("getLabels");
+    std::vector<Pothos::Label> reference = collectors[1].call("getLabels");
+    std::cout << "Frames found with search bounds: " << bounded.size() << std::endl;
+    POTHOS_TEST_TRUE(not reference.empty());
+    POTHOS_TEST_EQUAL(bounded.size(), reference.size());
+    for (size_t i = 0; i < bounded.size(); i++)
+    {
+        POTHOS_TEST_EQUAL(bounded[i].id, reference[i].id);
+        POTHOS_TEST_EQUAL(bounded[i].index, reference[i].index);
+        POTHOS_TEST_EQUAL(bounded[i].data.convert<size_t>(), reference[i].data.convert<size_t>());
+    }
+    Pothos::BufferChunk bufBounded = collectors[0].call("getBuffer");
+    Pothos::BufferChunk bufReference = collectors[1].call("getBuffer");
+    POTHOS_TEST_EQUAL(bufBounded.elements(), bufReference.elements());
+    POTHOS_TEST_EQUAL(syncs[0].call<unsigned long long>("getFramesDetected"), syncs[1].call<unsigned long long>("getFramesDetected"));
+    POTHOS_TEST_TRUE(syncs[0].call<unsigned long long>("getFineEvaluations") < syncs[1].call<unsigned long long>("getFineEvaluations"));
+}
+
+/***********************************************************************
+ * Compensate a long payload with a frequency offset:
+ * The recursive phasor is evaluated exactly every 1024 outputs,
+ * so the phase error of the outputs must not drift over the payload.
+ * The error is the phase of each output from the nearest QPSK symbol.
+ * The cubic interpolation of the rectangular pulse adds a data dependent
+ * error to the outputs, so the tolerances are given per test case.
+ **********************************************************************/
+static void testPayloadPhase(const std::string &mode, const std::string &interp, const double delay, const double maxTol, const double driftTol)
+{
+    std::cout << "Testing payload phase with " << mode << " mode, " << interp << " interpolation, delay " << delay << std::endl;
+
+    const auto dtype = Pothos::DType(typeid(Type));
+    const std::vector<Type> preamble = {1, 1, 1, -1, 1};
+    const size_t length = 4095;
+    const double freqOffset = 0.004; //radians per sample
+    const double phaseOffset = 0.7;
+
+    //apply the fractional delay and the frequency offset
+    const auto frames = insertFrames(preamble, 0x55, {randomPayload(length)});
+    const auto x = frames.as<const Type *>();
+    Pothos::BufferChunk waveform(dtype, frames.elements());
+    for (size_t n = 0; n < frames.elements(); n++)
+    {
+        const Type prev = (n == 0)?Type(0):x[n-1];
+        const Type delayed = Type(1-delay)*x[n] + Type(delay)*prev;
+        waveform.as<Type *>()[n] = delayed*std::polar<float>(1, float(std::fmod(phaseOffset + freqOffset*n, 2*M_PI)));
+    }
+
+    auto sync = Pothos::BlockRegistry::make("/comms/frame_sync", dtype);
+    sync.call("setPreamble", preamble);
+    sync.call("setSymbolWidth", symbolWidth);
+    sync.call("setDataWidth", dataWidth);
+    sync.call("setOutputMode", mode);
+    sync.call("setTimingInterpolation", interp);
+    auto collector = collectSync(sync, waveform);
+
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    const size_t width = (mode == "TIMING")?1:dataWidth;
+    POTHOS_TEST_EQUAL(buff.elements(), length*width);
+
+    //the phase error from the nearest QPSK symbol,
+    //skipping the trailing outputs that reach into the padding
+    std::vector<double> errors;
+    const auto out = buff.as<const Type *>();
+    for (size_t i = 0; i < buff.elements(); i++)
+    {
+        if (std::abs(out[i]) < 0.5) continue;
+        const double arg = std::arg(std::complex<double>(out[i]));
+        const double nearest = (std::floor(arg/(M_PI/2))+0.5)*(M_PI/2);
+        errors.push_back(arg-nearest);
+    }
+    POTHOS_TEST_TRUE(errors.size() > (length-1)*width);
+
+    //small errors, and no drift between the start and the end of the payload
+    double maxError = 0, firstMean = 0, lastMean = 0;
+    const size_t M = 256;
+    for (const auto err : errors) maxError = std::max(maxError, std::abs(err));
+    for (size_t i = 0; i < M; i++) firstMean += errors[i]/M;
+    for (size_t i = errors.size()-M; i < errors.size(); i++) lastMean += errors[i]/M;
+    std::cout << " max phase error " << maxError << ", drift " << (lastMean-firstMean) << std::endl;
+    POTHOS_TEST_TRUE(maxError < maxTol);
+    POTHOS_TEST_TRUE(std::abs(lastMean-firstMean) < driftTol);
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_frame_sync_payload_phase)
+{
+    testPayloadPhase("PHASE", "NEAREST", 0.0, 0.05, 1e-3);
+    testPayloadPhase("TIMING", "NEAREST", 0.0, 0.05, 1e-3);
+
+    //fractional timing offset, the phase advances by a data width per symbol
+    testPayloadPhase("TIMING", "CUBIC", 0.4, 0.1, 5e-3);
+}
+
+/***********************************************************************
+ * Interleave the frames of two transmitters with different
+ * preambles and header IDs, every frame is found in a single search
+ **********************************************************************/
+POTHOS_TEST_BLOCK("/comms/tests", test_frame_sync_multiple_transmitters)
+{
+    const auto dtype = Pothos::DType(typeid(Type));
+    const std::vector<std::vector<Type>> preambles = {{1, 1, 1, -1, 1}, {1, -1, 1, 1, 1}};
+    const std::vector<unsigned char> headerIds = {0x55, 0x2A};
+    const std::vector<size_t> lengths = {100, 237, 64, 512, 33, 150};
+
+    //each frame is inserted with the preamble and ID of its transmitter
+    std::vector<Type> waveform, expected;
+    for (size_t frameNo = 0; frameNo < lengths.size(); frameNo++)
+    {
+        const auto payload = randomPayload(lengths[frameNo]);
+        auto p = payload.as<const Type *>();
+        expected.insert(expected.end(), p, p+payload.elements());
+        const auto frame = insertFrames(preambles[frameNo%2], headerIds[frameNo%2], {payload});
+        auto f = frame.as<const Type *>();
+        waveform.insert(waveform.end(), f, f+frame.elements());
+    }
+    Pothos::BufferChunk waveformBuff(dtype, waveform.size());
+    std::copy(waveform.begin(), waveform.end(), waveformBuff.as<Type *>());
+
+    for (const size_t numThreads : {1, 4})
+    {
+        std::cout << "Testing multiple transmitters with " << numThreads << " search threads" << std::endl;
+        auto sync = Pothos::BlockRegistry::make("/comms/frame_sync", dtype);
+        sync.call("setPreamble", preambles[0]);
+        sync.call("setAdditionalPreambles", std::vector<std::vector<Type>>(1, preambles[1]));
+        sync.call("setHeaderId", headerIds[0]);
+        sync.call("setAdditionalHeaderIds", std::vector<unsigned char>(1, headerIds[1]));
+        sync.call("setSymbolWidth", symbolWidth);
+        sync.call("setDataWidth", dataWidth);
+        sync.call("setOutputMode", "TIMING");
+        sync.call("setFrameStartId", "rxFrameStart");
+        sync.call("setFrameEndId", "rxFrameEnd");
+        sync.call("setHeaderIdLabelId", "rxHeaderId");
+        sync.call("setNumThreads", numThreads);
+        auto collector = collectSync(sync, waveformBuff);
+
+        //every payload is forwarded
+        Pothos::BufferChunk buff = collector.call("getBuffer");
+        POTHOS_TEST_EQUAL(buff.elements(), expected.size());
+        auto out = buff.as<const Type *>();
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            POTHOS_TEST_TRUE(std::abs(out[i]-expected[i]) < 1e-3);
+        }
+
+        //the header ID label carries the ID of the transmitter
+        std::vector<Pothos::Label> labels = collector.call("getLabels");
+        size_t index = 0, frameNo = 0, numIds = 0;
+        for (const auto &label : labels)
+        {
+            if (label.id == "rxFrameStart")
+            {
+                POTHOS_TEST_TRUE(frameNo < lengths.size());
+                POTHOS_TEST_EQUAL(label.index, index);
+                POTHOS_TEST_EQUAL(label.data.convert<size_t>(), lengths[frameNo]);
+            }
+            if (label.id == "rxHeaderId")
+            {
+                POTHOS_TEST_TRUE(frameNo < lengths.size());
+                POTHOS_TEST_EQUAL(label.index, index);
+                POTHOS_TEST_EQUAL(label.data.convert<int>(), int(headerIds[frameNo%2]));
+                numIds++;
+            }
+            if (label.id == "rxFrameEnd")
+            {
+                index += lengths[frameNo++];
+                POTHOS_TEST_EQUAL(label.index, index-1);
+            }
+        }
+        POTHOS_TEST_EQUAL(frameNo, lengths.size());
+        POTHOS_TEST_EQUAL(numIds, lengths.size());
+        POTHOS_TEST_EQUAL(sync.call<unsigned long long>("getAcceptedFrames"), lengths.size());
+        POTHOS_TEST_EQUAL(sync.call<unsigned long long>("getHeaderIdRejects"), 0);
+    }
+}
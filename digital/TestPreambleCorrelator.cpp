@@ -6,6 +6,7 @@
 #include <Pothos/Proxy.hpp>
 #include <iostream>
 #include <complex>
+#include <random>
 
 POTHOS_TEST_BLOCK("/comms/tests", test_preamble_correlator)
 {
@@ -48,3 +49,106 @@ POTHOS_TEST_BLOCK("/comms/tests", test_preamble_correlator)
     POTHOS_TEST_EQUAL(labels.size(), 1);
     POTHOS_TEST_EQUAL(labels[0].index, preambleIndex + preamble.size());
 }
+
+POTHOS_TEST_BLOCK("/comms/tests", test_preamble_correlator_packed)
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "unsigned char");
+    auto correlator = Pothos::BlockRegistry::make("/comms/preamble_correlator");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "unsigned char");
+
+    //a random preamble that spans multiple packed words
+    std::mt19937 gen(0);
+    std::vector<unsigned char> preamble(150);
+    for (auto &bit : preamble) bit = gen() & 1;
+    size_t testLength = 1000 + preamble.size();
+    size_t preambleIndex = 321;
+
+    correlator.call("setPreamble", preamble);
+    correlator.call("setThreshold", 2);
+    correlator.call("setPackedBits", true);
+
+    //load feeder blocks with two preamble bit errors
+    auto b0 = Pothos::BufferChunk(testLength + preamble.size());
+    auto p0 = b0.as<unsigned char *>();
+    for (size_t i = 0; i < b0.elements(); i++) p0[i] = gen() & 1;
+    for (size_t i = 0; i < preamble.size(); i++) p0[i + preambleIndex] = preamble[i];
+    p0[preambleIndex + 7] ^= 1;
+    p0[preambleIndex + 100] ^= 1;
+    feeder.call("feedBuffer", b0);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, correlator, 0);
+        topology.connect(correlator, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check the collector buffer matches input
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(testLength, buff.elements());
+    auto pb = buff.as<const unsigned char *>();
+    POTHOS_TEST_EQUALA(pb, p0, testLength);
+
+    //check for the preamble label
+    std::vector<Pothos::Label> labels = collector.call("getLabels");
+    POTHOS_TEST_EQUAL(labels.size(), 1);
+    POTHOS_TEST_EQUAL(labels[0].index, preambleIndex + preamble.size());
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_preamble_correlator_distance)
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "unsigned char");
+    auto correlator = Pothos::BlockRegistry::make("/comms/preamble_correlator");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "unsigned char");
+    auto distCollector = Pothos::BlockRegistry::make("/blocks/collector_sink", "unsigned");
+
+    //random multi-bit symbols with a preamble longer than a SIMD accumulation block
+    std::mt19937 gen(0);
+    std::vector<unsigned char> preamble(40);
+    for (auto &sym : preamble) sym = gen() & 0xff;
+    size_t testLength = 1000 + preamble.size();
+    size_t preambleIndex = 123;
+
+    correlator.call("setDistanceOutput", true);
+    correlator.call("setPreamble", preamble);
+    correlator.call("setThreshold", 0);
+
+    //load feeder blocks
+    auto b0 = Pothos::BufferChunk(testLength + preamble.size());
+    auto p0 = b0.as<unsigned char *>();
+    for (size_t i = 0; i < b0.elements(); i++) p0[i] = gen() & 0xff;
+    for (size_t i = 0; i < preamble.size(); i++) p0[i + preambleIndex] = preamble[i];
+    feeder.call("feedBuffer", b0);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, correlator, 0);
+        topology.connect(correlator, 0, collector, 0);
+        topology.connect(correlator, 1, distCollector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check the distance stream against a simple loop
+    Pothos::BufferChunk distBuff = distCollector.call("getBuffer");
+    POTHOS_TEST_EQUAL(testLength, distBuff.elements());
+    auto pd = distBuff.as<const unsigned *>();
+    for (size_t n = 0; n < testLength; n++)
+    {
+        unsigned dist = 0;
+        for (size_t i = 0; i < preamble.size(); i++)
+        {
+            for (unsigned x = preamble[i] ^ p0[n+i]; x != 0; x &= x-1) dist++;
+        }
+        POTHOS_TEST_EQUAL(pd[n], dist);
+    }
+    POTHOS_TEST_EQUAL(pd[preambleIndex], 0);
+
+    //check for the preamble label
+    std::vector<Pothos::Label> labels = collector.call("getLabels");
+    POTHOS_TEST_EQUAL(labels.size(), 1);
+    POTHOS_TEST_EQUAL(labels[0].index, preambleIndex + preamble.size());
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
+#include <iostream>
+#include <complex>
+#include <random>
+
+template <typename Type>
+static void testSoftPreambleCorrelator(const Type &gain)
+{
+    const auto dtype = Pothos::DType(typeid(Type));
+    std::cout << "Testing soft preamble correlator with " << dtype.toString() << std::endl;
+
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+    auto correlator = Pothos::BlockRegistry::make("/comms/soft_preamble_correlator", dtype);
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+
+    //random preamble that is scaled and rotated by the gain in the input
+    std::mt19937 gen(0);
+    std::normal_distribution<float> noise(0, 0.1f);
+    std::vector<Type> preamble(32);
+    for (auto &sym : preamble) sym = (gen() & 1)?1:-1;
+    size_t testLength = 1000 + preamble.size();
+    size_t preambleIndex = 321;
+
+    correlator.call("setPreamble", preamble);
+    correlator.call("setThreshold", 0.8);
+
+    //load feeder blocks
+    auto b0 = Pothos::BufferChunk(dtype, testLength + preamble.size());
+    auto p0 = b0.as<Type *>();
+    for (size_t i = 0; i < b0.elements(); i++) p0[i] = Type(noise(gen));
+    for (size_t i = 0; i < preamble.size(); i++) p0[i + preambleIndex] += preamble[i]*gain;
+    feeder.call("feedBuffer", b0);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, correlator, 0);
+        topology.connect(correlator, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check the collector buffer matches input
+    //the last preamble-sized window of elements is left in the correlator
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(testLength, buff.elements());
+    auto pb = buff.as<const Type *>();
+    POTHOS_TEST_EQUALA(pb, p0, testLength);
+
+    //check for the preamble label and its normalized correlation
+    std::vector<Pothos::Label> labels = collector.call("getLabels");
+    POTHOS_TEST_EQUAL(labels.size(), 1);
+    POTHOS_TEST_EQUAL(labels[0].index, preambleIndex + preamble.size());
+    const auto corr = labels[0].data.convert<double>();
+    POTHOS_TEST_TRUE(corr > 0.8 and corr <= 1.0);
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_soft_preamble_correlator)
+{
+    testSoftPreambleCorrelator<float>(0.5f);
+    testSoftPreambleCorrelator<std::complex<float>>(std::polar(2.0f, 1.0f));
+}
@@ -0,0 +1,203 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#ifdef POTHOS_XSIMD
+#include "SIMD/FFTBlocks_SIMD.hpp"
+#endif
+
+#include "RadixFFT.hpp" //FFTAlignedVector
+#include <complex>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+/***********************************************************************
+ * Radix-2 butterfly stage on split int16 real/imag arrays:
+ * Twiddles are Q15, products are formed in 32-bit and rounded back,
+ * and the stage output is shifted down by the given number of bits.
+ * The largest output component magnitude is stored for the next stage.
+ * The vectorized stage widens the int16 values into 32-bit lanes.
+ **********************************************************************/
+using FFTBlockFloatStageFcn = void(*)(int16_t*, int16_t*, const int16_t*, const int16_t*, const size_t, const size_t, const int, int*);
+
+using FFTBlockFloatMaxAbsFcn = void(*)(const int16_t*, const size_t, int*);
+
+static void fftBlockFloatStageScalar(
+    int16_t *re, int16_t *im,
+    const int16_t *twr, const int16_t *twi,
+    const size_t N, const size_t h, const int shift, int *maxAbsOut)
+{
+    const int32_t rnd = (shift == 0)?0:(1 << (shift-1));
+    int32_t maxAbs = 0;
+    for (size_t b = 0; b < N; b += 2*h)
+    {
+        int16_t *ar = re+b, *ai = im+b, *br = re+b+h, *bi = im+b+h;
+        for (size_t k = 0; k < h; k++)
+        {
+            const int32_t tr = (int32_t(br[k])*twr[k] - int32_t(bi[k])*twi[k] + (1 << 14)) >> 15;
+            const int32_t ti = (int32_t(br[k])*twi[k] + int32_t(bi[k])*twr[k] + (1 << 14)) >> 15;
+            const int32_t xr = (int32_t(ar[k]) + tr + rnd) >> shift;
+            const int32_t xi = (int32_t(ai[k]) + ti + rnd) >> shift;
+            const int32_t yr = (int32_t(ar[k]) - tr + rnd) >> shift;
+            const int32_t yi = (int32_t(ai[k]) - ti + rnd) >> shift;
+            ar[k] = int16_t(xr); ai[k] = int16_t(xi);
+            br[k] = int16_t(yr); bi[k] = int16_t(yi);
+            maxAbs = std::max(maxAbs, std::max(std::max(std::abs(xr), std::abs(xi)), std::max(std::abs(yr), std::abs(yi))));
+        }
+    }
+    *maxAbsOut = int(maxAbs);
+}
+
+static void fftBlockFloatMaxAbsScalar(const int16_t *in, const size_t num, int *maxAbsOut)
+{
+    int32_t maxAbs = 0;
+    for (size_t i = 0; i < num; i++) maxAbs = std::max(maxAbs, std::abs(int32_t(in[i])));
+    *maxAbsOut = int(maxAbs);
+}
+
+#ifdef POTHOS_XSIMD
+
+static inline FFTBlockFloatStageFcn getBlockFloatStageFcn(void)
+{
+    return PothosCommsSIMD::fftBlockFloatStageDispatch<int16_t>();
+}
+
+static inline FFTBlockFloatMaxAbsFcn getBlockFloatMaxAbsFcn(void)
+{
+    return PothosCommsSIMD::fftBlockFloatMaxAbsDispatch<int16_t>();
+}
+
+#else
+
+static inline FFTBlockFloatStageFcn getBlockFloatStageFcn(void)
+{
+    return &fftBlockFloatStageScalar;
+}
+
+static inline FFTBlockFloatMaxAbsFcn getBlockFloatMaxAbsFcn(void)
+{
+    return &fftBlockFloatMaxAbsScalar;
+}
+
+#endif
+
+/***********************************************************************
+ * Block-floating-point power-of-two FFT for int16 complex samples:
+ * The input frame is normalized to use the available headroom,
+ * and each stage is scaled down only when its worst case growth
+ * (|a| + |w*b| <= (1+sqrt(2)) * max component) would overflow int16.
+ * The transform returns the block exponent such that the unscaled
+ * transform (sum without 1/N, like the floating point transforms)
+ * is the output multiplied by 2^exponent; the exponent may be negative.
+ * The engine is immutable after construction so that it can be
+ * shared between users; each caller provides its own scratch.
+ **********************************************************************/
+class BlockFloatFFT
+{
+public:
+    BlockFloatFFT(const size_t nfft, const bool inverse):
+        _nfft(nfft),
+        _inverse(inverse),
+        _bitrev(nfft),
+        _twr(nfft),
+        _twi(nfft),
+        _stage(getBlockFloatStageFcn()),
+        _maxAbs(getBlockFloatMaxAbsFcn())
+    {
+        //bit reversal permutation table
+        size_t numBits = 0;
+        while ((size_t(1) << numBits) < nfft) numBits++;
+        for (size_t n = 0; n < nfft; n++)
+        {
+            size_t r = 0;
+            for (size_t b = 0; b < numBits; b++) r |= ((n >> b) & 0x1) << (numBits-1-b);
+            _bitrev[n] = uint32_t(r);
+        }
+
+        //Q15 forward twiddles for the stage with half-span h at offset h-1
+        const double pi = std::acos(-1.0);
+        for (size_t h = 1; h < nfft; h *= 2)
+        {
+            for (size_t k = 0; k < h; k++)
+            {
+                _twr[h-1+k] = int16_t(std::lround(32767*std::cos(-pi*k/h)));
+                _twi[h-1+k] = int16_t(std::lround(32767*std::sin(-pi*k/h)));
+            }
+        }
+    }
+
+    //! True when the engine can perform a transform of this size
+    static bool supportsSize(const size_t nfft)
+    {
+        return nfft >= 2 and nfft <= (size_t(1) << 31) and (nfft & (nfft-1)) == 0;
+    }
+
+    //! The number of scratch elements that the caller must provide
+    size_t scratchSize(void) const
+    {
+        return 2*_nfft;
+    }
+
+    int transform(const std::complex<int16_t> *src, std::complex<int16_t> *dst, int16_t *scratch) const
+    {
+        //the inverse is the forward transform with real and imaginary swapped
+        int16_t *re = scratch, *im = scratch + _nfft;
+        int16_t *ioRe = _inverse?im:re;
+        int16_t *ioIm = _inverse?re:im;
+
+        //permute the input and find the largest component
+        for (size_t n = 0; n < _nfft; n++)
+        {
+            const auto r = _bitrev[n];
+            ioRe[r] = src[n].real();
+            ioIm[r] = src[n].imag();
+        }
+        int maxAbs = 0;
+        _maxAbs(scratch, 2*_nfft, &maxAbs);
+
+        //normalize small frames up to the stage threshold to keep precision
+        int exponent = 0;
+        if (maxAbs != 0)
+        {
+            int up = 0;
+            while ((maxAbs << (up+1)) <= MaxNoShift) up++;
+            if (up != 0)
+            {
+                for (size_t n = 0; n < 2*_nfft; n++) scratch[n] = int16_t(scratch[n] << up);
+                maxAbs <<= up;
+                exponent -= up;
+            }
+        }
+
+        //each stage only scales down as much as needed to avoid overflow
+        for (size_t h = 1; h < _nfft; h *= 2)
+        {
+            int shift = 0;
+            while (maxAbs > (MaxNoShift << shift)) shift++;
+            _stage(re, im, _twr.data()+h-1, _twi.data()+h-1, _nfft, h, shift, &maxAbs);
+            exponent += shift;
+        }
+
+        for (size_t n = 0; n < _nfft; n++)
+        {
+            dst[n] = std::complex<int16_t>(ioRe[n], ioIm[n]);
+        }
+        return exponent;
+    }
+
+private:
+    //largest component where one butterfly cannot overflow: 32767/(1+sqrt(2)) minus rounding
+    static const int MaxNoShift = 13570;
+
+    const size_t _nfft;
+    const bool _inverse;
+    std::vector<uint32_t> _bitrev;
+    FFTAlignedVector<int16_t> _twr;
+    FFTAlignedVector<int16_t> _twi;
+    FFTBlockFloatStageFcn _stage;
+    FFTBlockFloatMaxAbsFcn _maxAbs;
+};
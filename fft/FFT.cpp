@@ -5,7 +5,10 @@
 #include <cstdint>
 #include <complex>
 #include <cmath>
+#include <memory>
+#include <vector>
 #include "FFTAux.h"
+#include "FFTOutputMode.hpp"
 
 /***********************************************************************
  * |PothosDoc FFT
@@ -13,11 +16,59 @@
  * Perform a Fast Fourier Transform on input port 0
  * and produce the FFT result to output port 0.
  *
+ * <h2>Real transforms</h2>
+ *
+ * When the data type is real, the block performs a real-to-complex
+ * forward transform or a complex-to-real inverse transform.
+ * The forward transform consumes numBins real samples
+ * and produces the numBins/2+1 non-redundant complex bins.
+ * The inverse transform consumes numBins/2+1 complex bins
+ * and produces numBins real samples.
+ * The real transforms require an even number of bins,
+ * and cost about half of the equivalent complex transform.
+ *
+ * <h2>Block floating point</h2>
+ *
+ * Fixed point transforms with kissfft scale down by 1/numBins,
+ * which loses dynamic range for small signals in large transforms.
+ * The "bfp" backend performs a block-floating-point transform instead:
+ * the frame is normalized to use the available headroom,
+ * each stage is scaled only when it could overflow,
+ * and the block exponent is posted as a label on the first element of each frame.
+ * The unscaled transform is the output multiplied by 2^exponent.
+ *
+ * <h2>Output modes</h2>
+ *
+ * The output can be the complex bins, or the magnitude, power, or power in dB
+ * of each bin. The conversion is fused with the final stores of the transform,
+ * which replaces separate abs, square, and log blocks after the FFT.
+ * The real output modes produce real elements of the same precision,
+ * or 32-bit floats for fixed point transforms.
+ * The optional fftshift ordering moves the zero frequency bin to the center
+ * of the output, and is also applied during the final stores.
+ * Real-to-complex transforms only support the output modes in the forward direction,
+ * and their one-sided spectrum is never shifted.
+ *
+ * <h2>Multi-channel transforms</h2>
+ *
+ * When the data type has a dimension greater than 1, every input element
+ * holds one sample of each channel, such as the synchronized channels of an antenna array.
+ * The block transforms all channels in the same call, and every output element
+ * holds one bin of each channel in the same interleaved order.
+ * Complex floating point channels are transformed by the batched radix engine,
+ * which runs each butterfly across the channels with full-width vector operations,
+ * so small transforms of many channels vectorize as well as one large transform.
+ * The other backends transform one channel at a time,
+ * and the block-floating-point backend is not available for multiple channels.
+ *
  * |category /FFT
  * |keywords dft fft fast fourier transform
  *
  * |param dtype[Data Type] The data type of the input and output element stream.
- * |widget DTypeChooser(cfloat=1, cint=1)
+ * For real types, this is the type of the time-domain samples,
+ * and the frequency-domain bins are complex of the same precision.
+ * The dimension of the data type is the number of interleaved channels.
+ * |widget DTypeChooser(float=1, cfloat=1, cint=1, dim=1)
  * |default "complex_float32"
  * |preview disable
  *
@@ -34,27 +85,162 @@
  * |option [Inverse] true
  * |default false
  *
+ * |param output[Output Mode] The conversion applied to the transform output.
+ * The output mode selects the output port data type,
+ * and can only be changed before the block is activated.
+ * |option [Complex] "COMPLEX"
+ * |option [Magnitude] "MAGNITUDE"
+ * |option [Power] "POWER"
+ * |option [Power dB] "DB"
+ * |default "COMPLEX"
+ * |preview disable
+ *
+ * |param fftShift[FFT Shift] Reorder the output so that the zero frequency bin is centered.
+ * |option [Disable] false
+ * |option [Enable] true
+ * |default false
+ * |preview valid
+ *
+ * |param backend[Backend] The FFT implementation used to perform the transform.
+ * <ul>
+ * <li>"kissfft" uses the mixed-radix kissfft implementation (any size).</li>
+ * <li>"simd" uses the vectorized radix-2^2 engine (power-of-two sizes),
+ * and falls back to kissfft for other sizes.</li>
+ * <li>"auto" selects the vectorized engine for power-of-two sizes of at least 64 bins
+ * (counting the bins of every channel).</li>
+ * <li>"bfp" uses the block-floating-point engine for fixed point types (power-of-two sizes),
+ * and is the same as "auto" for floating point types.</li>
+ * <li>"fourstep" uses the multi-threaded four-step decomposition for floating point types
+ * (any size with a factorization). "auto" selects it for at least 2^18 bins with multiple threads,
+ * or for at least 2^22 bins with a single thread.</li>
+ * </ul>
+ * Fixed point transforms otherwise use kissfft.
+ * |default "auto"
+ * |option [Automatic] "auto"
+ * |option [KissFFT] "kissfft"
+ * |option [SIMD] "simd"
+ * |option [Block Float] "bfp"
+ * |option [Four Step] "fourstep"
+ * |preview disable
+ * |tab Advanced
+ *
+ * |param numThreads[Num Threads] The number of threads used by the four-step backend.
+ * The four-step transform splits large transforms into many small row transforms,
+ * which are distributed over a pool of worker threads owned by this block.
+ * Use 0 for one thread per hardware thread.
+ * |default 1
+ * |preview valid
+ * |tab Advanced
+ *
+ * |param exponentId[Exponent ID] The label ID for the block exponent of each frame.
+ * Only used by the block-floating-point backend.
+ * |default "fftExp"
+ * |widget StringEntry()
+ * |preview valid
+ * |tab Advanced
+ *
  * |factory /comms/fft(dtype, numBins, inverse)
+ * |setter setOutputMode(output)
+ * |setter setFFTShift(fftShift)
+ * |setter setBackend(backend)
+ * |setter setNumThreads(numThreads)
+ * |setter setExponentId(exponentId)
  **********************************************************************/
 template <typename Type>
 class FFT : public Pothos::Block
 {
 public:
-    FFT(const size_t numBins, const bool inverse):
+    typedef typename FFTAux<Type>::RealOutputType RealType;
+
+    FFT(const size_t numBins, const size_t numChannels, const bool inverse):
         _numBins(numBins),
+        _numChannels(numChannels),
         _inverse(inverse),
-        _fftAux(numBins, inverse)
+        _outputMode(FFT_OUTPUT_COMPLEX),
+        _fftShift(false),
+        _backend("auto"),
+        _numThreads(1)
     {
-        this->setupInput(0, typeid(Type));
-        this->setupOutput(0, typeid(Type));
+        this->setupInput(0, Pothos::DType(typeid(Type), numChannels));
         this->input(0)->setReserve(_numBins);
+        this->registerCall(this, POTHOS_FCN_TUPLE(FFT, setOutputMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FFT, getOutputMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FFT, setFFTShift));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FFT, getFFTShift));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FFT, setBackend));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FFT, getBackend));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FFT, setNumThreads));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FFT, getNumThreads));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FFT, setExponentId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FFT, getExponentId));
+        this->setOutputMode("COMPLEX"); //initial update
+        this->setBackend("auto"); //initial update
+        this->setExponentId("fftExp"); //initial update
+    }
+
+    //! The output mode selects the output port type, so it is set before activation
+    void setOutputMode(const std::string &output)
+    {
+        if (this->isActive()) throw Pothos::InvalidArgumentException("FFT::setOutputMode("+output+")", "cannot change output mode while active");
+        _outputMode = parseFFTOutputMode(output);
+        _outputModeStr = output;
+        if (_outputMode == FFT_OUTPUT_COMPLEX) this->setupOutput(0, Pothos::DType(typeid(Type), _numChannels));
+        else this->setupOutput(0, Pothos::DType(typeid(RealType), _numChannels));
+    }
+
+    std::string getOutputMode(void) const
+    {
+        return _outputModeStr;
+    }
+
+    void setFFTShift(const bool fftShift)
+    {
+        _fftShift = fftShift;
+    }
+
+    bool getFFTShift(void) const
+    {
+        return _fftShift;
+    }
+
+    void setBackend(const std::string &backend)
+    {
+        if (not isValidFFTBackend(backend)) throw Pothos::InvalidArgumentException("FFT::setBackend("+backend+")", "unknown backend");
+        _backend = backend;
+        this->update();
+    }
+
+    std::string getBackend(void) const
+    {
+        return _fftAux->backend();
+    }
+
+    void setNumThreads(const size_t numThreads)
+    {
+        _numThreads = numThreads;
+        this->update();
+    }
+
+    size_t getNumThreads(void) const
+    {
+        return _numThreads;
+    }
+
+    void setExponentId(const std::string &id)
+    {
+        _exponentId = id;
+    }
+
+    std::string getExponentId(void) const
+    {
+        return _exponentId;
     }
 
     //! Custom output buffer manager with slabs large enough for the fft result
     Pothos::BufferManager::Sptr getOutputBufferManager(const std::string &, const std::string &)
     {
         Pothos::BufferManagerArgs args;
-        args.bufferSize = _numBins*sizeof(Type);
+        args.bufferSize = _numBins*this->output(0)->dtype().size();
         return Pothos::BufferManager::make("generic", args);
     }
 
@@ -62,19 +248,237 @@ public:
     {
         auto inPort = this->input(0);
         auto outPort = this->output(0);
+        const size_t offset = _fftShift?(_numBins/2):0;
 
-        _fftAux.transform(
+        if (_outputMode == FFT_OUTPUT_COMPLEX) _fftAux->transform(
             inPort->buffer().template as<const Type*>(),
-            outPort->buffer().template as<Type*>());
+            outPort->buffer().template as<Type*>(),
+            offset);
+
+        else _fftAux->transform(
+            inPort->buffer().template as<const Type*>(),
+            outPort->buffer().template as<RealType*>(),
+            _outputMode, offset);
+
+        if (_fftAux->isBlockFloat()) outPort->postLabel(_exponentId, _fftAux->exponent(), 0);
 
         inPort->consume(_numBins);
         outPort->produce(_numBins);
     }
 
 private:
+    void update(void)
+    {
+        _fftAux.reset(new FFTAux<Type>(_numBins, _inverse, _backend, _numThreads, _numChannels));
+    }
+
+    const size_t _numBins;
+    const size_t _numChannels;
+    const bool _inverse;
+    FFTOutputMode _outputMode;
+    std::string _outputModeStr;
+    bool _fftShift;
+    std::string _backend;
+    size_t _numThreads;
+    std::unique_ptr<FFTAux<Type>> _fftAux;
+    std::string _exponentId;
+};
+
+/***********************************************************************
+ * Real-to-complex and complex-to-real variant
+ **********************************************************************/
+template <typename Type>
+class RealFFT : public Pothos::Block
+{
+public:
+    RealFFT(const size_t numBins, const size_t numChannels, const bool inverse):
+        _numBins(numBins),
+        _numChannels(numChannels),
+        _inverse(inverse),
+        _outputMode(FFT_OUTPUT_COMPLEX),
+        _fftShift(false),
+        _backend("auto"),
+        _numThreads(1)
+    {
+        if (numChannels > 1)
+        {
+            _stageReal.resize(numBins);
+            _stageComplex.resize(numBins/2+1);
+        }
+        this->setupInput(0, Pothos::DType(inverse?typeid(std::complex<Type>):typeid(Type), numChannels));
+        this->registerCall(this, POTHOS_FCN_TUPLE(RealFFT, setOutputMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(RealFFT, getOutputMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(RealFFT, setFFTShift));
+        this->registerCall(this, POTHOS_FCN_TUPLE(RealFFT, getFFTShift));
+        this->registerCall(this, POTHOS_FCN_TUPLE(RealFFT, setBackend));
+        this->registerCall(this, POTHOS_FCN_TUPLE(RealFFT, getBackend));
+        this->registerCall(this, POTHOS_FCN_TUPLE(RealFFT, setNumThreads));
+        this->registerCall(this, POTHOS_FCN_TUPLE(RealFFT, getNumThreads));
+        this->registerCall(this, POTHOS_FCN_TUPLE(RealFFT, setExponentId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(RealFFT, getExponentId));
+        this->setOutputMode("COMPLEX"); //initial update
+        this->setBackend("auto"); //initial update
+        this->setExponentId("fftExp"); //initial update
+        this->input(0)->setReserve(this->inputSize());
+    }
+
+    //! The output mode selects the output port type, so it is set before activation
+    void setOutputMode(const std::string &output)
+    {
+        if (this->isActive()) throw Pothos::InvalidArgumentException("FFT::setOutputMode("+output+")", "cannot change output mode while active");
+        const auto outputMode = parseFFTOutputMode(output);
+        if (_inverse and outputMode != FFT_OUTPUT_COMPLEX) throw Pothos::InvalidArgumentException("FFT::setOutputMode("+output+")", "inverse real transform only supports complex output mode");
+        _outputMode = outputMode;
+        _outputModeStr = output;
+        _spectrum.resize((outputMode == FFT_OUTPUT_COMPLEX and _numChannels == 1)?0:(_numBins/2+1));
+        this->setupOutput(0, Pothos::DType((_inverse or outputMode != FFT_OUTPUT_COMPLEX)?typeid(Type):typeid(std::complex<Type>), _numChannels));
+    }
+
+    std::string getOutputMode(void) const
+    {
+        return _outputModeStr;
+    }
+
+    //! The one-sided spectrum of a real transform is never shifted
+    void setFFTShift(const bool fftShift)
+    {
+        _fftShift = fftShift;
+    }
+
+    bool getFFTShift(void) const
+    {
+        return _fftShift;
+    }
+
+    void setBackend(const std::string &backend)
+    {
+        if (not isValidFFTBackend(backend)) throw Pothos::InvalidArgumentException("FFT::setBackend("+backend+")", "unknown backend");
+        _backend = backend;
+        this->update();
+    }
+
+    std::string getBackend(void) const
+    {
+        return _fftAux->backend();
+    }
+
+    void setNumThreads(const size_t numThreads)
+    {
+        _numThreads = numThreads;
+        this->update();
+    }
+
+    size_t getNumThreads(void) const
+    {
+        return _numThreads;
+    }
+
+    //! Real transforms are floating point and never post an exponent
+    void setExponentId(const std::string &id)
+    {
+        _exponentId = id;
+    }
+
+    std::string getExponentId(void) const
+    {
+        return _exponentId;
+    }
+
+    //! Custom output buffer manager with slabs large enough for the fft result
+    Pothos::BufferManager::Sptr getOutputBufferManager(const std::string &, const std::string &)
+    {
+        Pothos::BufferManagerArgs args;
+        args.bufferSize = this->outputSize()*this->output(0)->dtype().size();
+        return Pothos::BufferManager::make("generic", args);
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        auto outPort = this->output(0);
+
+        if (_numChannels > 1) for (size_t c = 0; c < _numChannels; c++)
+        {
+            this->transformChannel(c, inPort->buffer().template as<const void *>(), outPort->buffer().template as<void *>());
+        }
+
+        else if (_inverse) _fftAux->transform(
+            inPort->buffer().template as<const std::complex<Type>*>(),
+            outPort->buffer().template as<Type*>());
+
+        else if (_outputMode == FFT_OUTPUT_COMPLEX) _fftAux->transform(
+            inPort->buffer().template as<const Type*>(),
+            outPort->buffer().template as<std::complex<Type>*>());
+
+        else
+        {
+            _fftAux->transform(inPort->buffer().template as<const Type*>(), _spectrum.data());
+            convertFFTOutput(_outputMode, _spectrum.data(), outPort->buffer().template as<Type*>(), _spectrum.size());
+        }
+
+        inPort->consume(this->inputSize());
+        outPort->produce(this->outputSize());
+    }
+
+private:
+    //! Transform channel c of the interleaved buffers through the staging buffers
+    void transformChannel(const size_t c, const void *inBuff, void *outBuff)
+    {
+        const size_t numComplex = _numBins/2+1;
+        if (_inverse)
+        {
+            const auto in = reinterpret_cast<const std::complex<Type> *>(inBuff);
+            const auto out = reinterpret_cast<Type *>(outBuff);
+            for (size_t n = 0; n < numComplex; n++) _stageComplex[n] = in[n*_numChannels+c];
+            _fftAux->transform(_stageComplex.data(), _stageReal.data());
+            for (size_t n = 0; n < _numBins; n++) out[n*_numChannels+c] = _stageReal[n];
+            return;
+        }
+
+        const auto in = reinterpret_cast<const Type *>(inBuff);
+        for (size_t n = 0; n < _numBins; n++) _stageReal[n] = in[n*_numChannels+c];
+        _fftAux->transform(_stageReal.data(), _spectrum.data());
+        if (_outputMode == FFT_OUTPUT_COMPLEX)
+        {
+            const auto out = reinterpret_cast<std::complex<Type> *>(outBuff);
+            for (size_t n = 0; n < numComplex; n++) out[n*_numChannels+c] = _spectrum[n];
+        }
+        else
+        {
+            const auto out = reinterpret_cast<Type *>(outBuff);
+            convertFFTOutput(_outputMode, _spectrum.data(), _stageReal.data(), numComplex);
+            for (size_t n = 0; n < numComplex; n++) out[n*_numChannels+c] = _stageReal[n];
+        }
+    }
+
+    void update(void)
+    {
+        _fftAux.reset(new FFTRealAux<Type>(_numBins, _inverse, _backend, _numThreads));
+    }
+
+    size_t inputSize(void) const
+    {
+        return _inverse?(_numBins/2+1):_numBins;
+    }
+
+    size_t outputSize(void) const
+    {
+        return _inverse?_numBins:(_numBins/2+1);
+    }
+
     const size_t _numBins;
+    const size_t _numChannels;
     const bool _inverse;
-    FFTAux<Type> _fftAux;
+    FFTOutputMode _outputMode;
+    std::string _outputModeStr;
+    bool _fftShift;
+    std::string _backend;
+    size_t _numThreads;
+    std::vector<std::complex<Type>> _spectrum;
+    std::vector<Type> _stageReal;
+    std::vector<std::complex<Type>> _stageComplex;
+    std::unique_ptr<FFTRealAux<Type>> _fftAux;
+    std::string _exponentId;
 };
 
 /***********************************************************************
@@ -82,8 +486,21 @@ private:
  **********************************************************************/
 static Pothos::Block *FFTFactory(const Pothos::DType &dtype, const size_t numBins, const bool inverse)
 {
+    if (numBins == 0) throw Pothos::InvalidArgumentException("FFTFactory()", "num bins cannot be 0");
+    const auto elemType = Pothos::DType::fromDType(dtype, 1);
+    const size_t numChannels = dtype.dimension();
+
+    #define ifRealTypeDeclareFactory(Type) \
+        if (elemType == Pothos::DType(typeid(Type))) \
+        { \
+            if ((numBins % 2) != 0) throw Pothos::InvalidArgumentException("FFTFactory("+dtype.toString()+")", "real transform requires an even number of bins"); \
+            return new RealFFT<Type>(numBins, numChannels, inverse); \
+        }
+    ifRealTypeDeclareFactory(double);
+    ifRealTypeDeclareFactory(float);
+
     #define ifTypeDeclareFactory__(Type) \
-        if (dtype == Pothos::DType(typeid(Type))) return new FFT<Type>(numBins, inverse);
+        if (elemType == Pothos::DType(typeid(Type))) return new FFT<Type>(numBins, numChannels, inverse);
     #define ifTypeDeclareFactory(Type) \
         ifTypeDeclareFactory__(std::complex<Type>)
     ifTypeDeclareFactory(double);
@@ -1,48 +1,345 @@
 #pragma once
 
 #include <complex>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cmath>
+#include <algorithm> //rotate
 
 #include "kissfft.hh"
 #include "kiss_fft.h"
+#include "RadixFFT.hpp"
+#include "BlockFloatFFT.hpp"
+#include "FFTPlanCache.hpp"
+#include "FourStepFFT.hpp"
+#include "FFTOutputMode.hpp"
+
+//! Check that the backend name is one of the supported options
+static inline bool isValidFFTBackend(const std::string &backend)
+{
+    return backend == "auto" or backend == "kissfft" or backend == "simd" or backend == "bfp" or backend == "fourstep";
+}
 
 template<typename Type>
 class FFTAux {
 private:
     // Don't allow to use this class without specialization.
     FFTAux() = delete;
-    FFTAux(size_t numBins, bool inverse) = delete;
+    FFTAux(size_t numBins, bool inverse, const std::string &backend, const size_t numThreads) = delete;
 };
 
+/***********************************************************************
+ * Floating point transforms select between the templated kissfft
+ * and the vectorized radix engine (power-of-two sizes only).
+ * The "auto" backend picks the radix engine for power-of-two sizes
+ * of at least 64 bins, where it outperforms kissfft,
+ * and the multi-threaded four-step decomposition for large sizes.
+ * Plans come from the process-wide cache, only scratch is per-instance.
+ *
+ * A batch of channel-interleaved transforms uses the batched radix engine,
+ * which vectorizes across channels, so "auto" selects it once the batch
+ * has at least 64 points in total. The other backends transform
+ * one channel at a time through a deinterleaved staging buffer.
+ **********************************************************************/
 template<typename Type>
 class FFTAux<std::complex<Type>> {
 public:
-    inline FFTAux(size_t numBins, bool inverse) : _fftFloat(numBins, inverse) {}
+    //! The element type for the real output modes
+    typedef Type RealOutputType;
+
+    inline FFTAux(size_t numBins, bool inverse, const std::string &backend = "auto", const size_t numThreads = 1, const size_t batch = 1) :
+        _numBins(numBins),
+        _batch(batch)
+    {
+        //the block-floating-point backend only applies to fixed point, select as auto
+        const bool isAuto = backend == "auto" or backend == "bfp";
+        const bool useFourStep = FourStepFFT<Type>::supportsSize(numBins) and
+            (backend == "fourstep" or (isAuto and numBins >= ((numThreads == 1)?FourStepMinBins1:FourStepMinBinsN)));
+        const bool useRadix = RadixFFT<Type>::supportsSize(numBins) and
+            (backend == "simd" or (isAuto and numBins*batch >= 64));
+        if (useFourStep) _fftFourStep.reset(new FourStepFFT<Type>(numBins, inverse, numThreads));
+        else if (useRadix)
+        {
+            _fftRadix = getCachedFFTPlan<RadixFFT<Type>>(numBins, inverse, batch);
+            _scratch.resize(_fftRadix->scratchSize());
+        }
+        else _fftFloat = getCachedFFTPlan<kissfft<Type>>(numBins, inverse);
+        if (batch > 1 and not _fftRadix)
+        {
+            _stageIn.resize(numBins);
+            _stageOut.resize(numBins);
+        }
+    }
+
+    //! The name of the backend that was actually selected
+    inline std::string backend(void) const {
+        if (_fftFourStep) return "fourstep";
+        return _fftRadix?"simd":"kissfft";
+    }
+
+    //! Floating point transforms do not produce a block exponent
+    inline bool isBlockFloat(void) const {
+        return false;
+    }
 
-    inline void transform(const std::complex<Type> *input, std::complex<Type> *output) {
-        _fftFloat.transform(input, output);
+    inline int exponent(void) const {
+        return 0;
+    }
+
+    /*!
+     * The input and output must not overlap.
+     * Bin k is stored at (k + offset) % numBins, use numBins/2 for fftshift.
+     * The radix engine applies the offset in its final stores.
+     * Batched transforms interleave the channels of the input and output.
+     */
+    inline void transform(const std::complex<Type> *input, std::complex<Type> *output, const size_t offset = 0) {
+        if (_fftRadix)
+        {
+            _fftRadix->transform(input, output, _scratch.data(), offset);
+            return;
+        }
+        if (_batch > 1) for (size_t c = 0; c < _batch; c++)
+        {
+            for (size_t n = 0; n < _numBins; n++) _stageIn[n] = input[n*_batch+c];
+            this->transformChannel(_stageIn.data(), _stageOut.data(), offset);
+            for (size_t n = 0; n < _numBins; n++) output[n*_batch+c] = _stageOut[n];
+        }
+        else this->transformChannel(input, output, offset);
+    }
+
+    //! Transform and convert into a real output mode in the same pass
+    inline void transform(const std::complex<Type> *input, Type *output, const FFTOutputMode mode, const size_t offset = 0) {
+        const size_t total = _numBins*_batch;
+        if (_fftRadix)
+        {
+            _fftRadix->transform(input, _scratch.data(), [&](const Type *re, const Type *im)
+            {
+                convertFFTOutput(mode, re, im, output, total, offset*_batch);
+            });
+            return;
+        }
+        _spectrum.resize(total);
+        this->transform(input, _spectrum.data());
+        convertFFTOutput(mode, _spectrum.data(), output, total, offset*_batch);
     }
 
 private:
-    kissfft<Type> _fftFloat;
+    inline void transformChannel(const std::complex<Type> *input, std::complex<Type> *output, const size_t offset) {
+        if (_fftFourStep) _fftFourStep->transform(input, output);
+        else _fftFloat->transform(input, output);
+        if (offset != 0) std::rotate(output, output+_numBins-offset, output+_numBins);
+    }
+
+    //! Automatic four-step sizes: beyond the cache single-threaded, or when parallel
+    static const size_t FourStepMinBins1 = size_t(1) << 22;
+    static const size_t FourStepMinBinsN = size_t(1) << 18;
+
+    const size_t _numBins;
+    const size_t _batch;
+    std::shared_ptr<kissfft<Type>> _fftFloat;
+    std::shared_ptr<RadixFFT<Type>> _fftRadix;
+    FFTAlignedVector<Type> _scratch;
+    std::unique_ptr<FourStepFFT<Type>> _fftFourStep;
+    std::vector<std::complex<Type>> _spectrum;
+    std::vector<std::complex<Type>> _stageIn;
+    std::vector<std::complex<Type>> _stageOut;
+};
+
+//! Owner of a fixed point kiss_fft configuration for the plan cache
+struct KissFFTFixedPlan
+{
+    KissFFTFixedPlan(const size_t nfft, const bool inverse):
+        cfg(kiss_fft_alloc(int(nfft), inverse?1:0, nullptr, nullptr))
+    {
+        return;
+    }
+
+    ~KissFFTFixedPlan(void)
+    {
+        kiss_fft_free(cfg);
+    }
+
+    const kiss_fft_cfg cfg;
+
+private:
+    KissFFTFixedPlan(const KissFFTFixedPlan &) = delete;
+    KissFFTFixedPlan &operator=(const KissFFTFixedPlan &) = delete;
 };
 
+/***********************************************************************
+ * Fixed point transforms use kissfft, which scales by 1/N,
+ * or the block-floating-point engine for the "bfp" backend
+ * (power-of-two sizes only), which scales only when needed
+ * and reports the block exponent of the last transform.
+ * A batch of channel-interleaved transforms uses kissfft on one channel
+ * at a time, because every channel would need its own block exponent.
+ **********************************************************************/
 template<>
 class FFTAux<std::complex<kiss_fft_scalar>> {
 public:
-    inline FFTAux(size_t numBins, bool inverse) : _fftFixed(nullptr) {
-        _fftFixed = kiss_fft_alloc(numBins, inverse, nullptr, nullptr);
+    //! The real output modes of fixed point bins are floating point
+    typedef float RealOutputType;
+
+    inline FFTAux(size_t numBins, bool inverse, const std::string &backend = "auto", const size_t = 1, const size_t batch = 1) :
+        _numBins(numBins),
+        _batch(batch),
+        _exponent(0)
+    {
+        if (backend == "bfp" and batch == 1 and BlockFloatFFT::supportsSize(numBins))
+        {
+            _fftBlockFloat = getCachedFFTPlan<BlockFloatFFT>(numBins, inverse);
+            _scratch.resize(_fftBlockFloat->scratchSize());
+        }
+        else _fftFixed = getCachedFFTPlan<KissFFTFixedPlan>(numBins, inverse);
+        if (batch > 1)
+        {
+            _stageIn.resize(numBins);
+            _stageOut.resize(numBins);
+        }
+    }
+
+    //! The name of the backend that was actually selected
+    inline std::string backend(void) const {
+        return _fftBlockFloat?"bfp":"kissfft";
     }
 
-    inline ~FFTAux() {
-        kiss_fft_free(_fftFixed);
+    //! True when the output is block-floating-point with an exponent
+    inline bool isBlockFloat(void) const {
+        return bool(_fftBlockFloat);
     }
 
-    inline void transform(const std::complex<kiss_fft_scalar> *input, std::complex<kiss_fft_scalar> *output) {
-        kiss_fft(_fftFixed,
+    //! The block exponent of the last transform: unscaled = output*2^exponent
+    inline int exponent(void) const {
+        return _exponent;
+    }
+
+    //! Bin k is stored at (k + offset) % numBins, use numBins/2 for fftshift
+    inline void transform(const std::complex<kiss_fft_scalar> *input, std::complex<kiss_fft_scalar> *output, const size_t offset = 0) {
+        if (_batch > 1) for (size_t c = 0; c < _batch; c++)
+        {
+            for (size_t n = 0; n < _numBins; n++) _stageIn[n] = input[n*_batch+c];
+            this->transformChannel(_stageIn.data(), _stageOut.data(), offset);
+            for (size_t n = 0; n < _numBins; n++) output[n*_batch+c] = _stageOut[n];
+        }
+        else this->transformChannel(input, output, offset);
+    }
+
+    //! Transform and convert the fixed point bins into a real output mode
+    inline void transform(const std::complex<kiss_fft_scalar> *input, float *output, const FFTOutputMode mode, const size_t offset = 0) {
+        const size_t total = _numBins*_batch;
+        _spectrum.resize(total);
+        this->transform(input, _spectrum.data());
+        convertFFTOutput(mode, _spectrum.data(), output, total, offset*_batch);
+    }
+
+private:
+    inline void transformChannel(const std::complex<kiss_fft_scalar> *input, std::complex<kiss_fft_scalar> *output, const size_t offset) {
+        if (_fftBlockFloat) _exponent = _fftBlockFloat->transform(
+            reinterpret_cast<const std::complex<int16_t>*>(input),
+            reinterpret_cast<std::complex<int16_t>*>(output),
+            _scratch.data());
+        else kiss_fft(_fftFixed->cfg,
             reinterpret_cast<const kiss_fft_cpx*>(input),
             reinterpret_cast<kiss_fft_cpx*>(output));
+        if (offset != 0) std::rotate(output, output+_numBins-offset, output+_numBins);
+    }
+
+    const size_t _numBins;
+    const size_t _batch;
+    std::shared_ptr<KissFFTFixedPlan> _fftFixed;
+    std::shared_ptr<BlockFloatFFT> _fftBlockFloat;
+    FFTAlignedVector<int16_t> _scratch;
+    std::vector<std::complex<kiss_fft_scalar>> _spectrum;
+    std::vector<std::complex<kiss_fft_scalar>> _stageIn;
+    std::vector<std::complex<kiss_fft_scalar>> _stageOut;
+    int _exponent;
+};
+
+/***********************************************************************
+ * Real-input transform using the packed N/2 complex trick:
+ * The forward transform packs even and odd real samples into
+ * the real and imaginary parts of a half-size complex FFT,
+ * and then splits the result into N/2+1 non-redundant bins.
+ * The inverse transform performs the same steps in reverse.
+ * Scaling follows the complex transform (inverse is not scaled).
+ **********************************************************************/
+template<typename Type>
+class FFTRealAux {
+public:
+    FFTRealAux(size_t numBins, bool inverse, const std::string &backend = "auto", const size_t numThreads = 1) :
+        _numBins(numBins),
+        _inverse(inverse),
+        _fftHalf(numBins/2, inverse, backend, numThreads),
+        _twiddles(numBins/2),
+        _scratch(inverse?numBins/2:0)
+    {
+        const double phinc = (inverse?2:-2)*std::acos(-1.0)/numBins;
+        for (size_t k = 0; k < _twiddles.size(); k++)
+        {
+            _twiddles[k] = std::complex<Type>(std::polar(1.0, k*phinc));
+        }
+    }
+
+    //! The name of the backend used for the half-size transform
+    std::string backend(void) const
+    {
+        return _fftHalf.backend();
+    }
+
+    //! The number of complex bins on the frequency side of the transform
+    size_t numComplexBins(void) const
+    {
+        return _numBins/2+1;
+    }
+
+    //! Forward: numBins real samples in, numBins/2+1 complex bins out
+    void transform(const Type *input, std::complex<Type> *output)
+    {
+        const size_t M = _numBins/2;
+        _fftHalf.transform(reinterpret_cast<const std::complex<Type> *>(input), output);
+
+        //split the packed result in-place, processing bins k and M-k together
+        const auto z0 = output[0];
+        output[0] = std::complex<Type>(z0.real() + z0.imag(), 0);
+        output[M] = std::complex<Type>(z0.real() - z0.imag(), 0);
+        for (size_t k = 1; k <= M/2; k++)
+        {
+            const auto a = output[k];
+            const auto b = output[M-k];
+            output[k] = this->splitBin(a, b, _twiddles[k]);
+            output[M-k] = this->splitBin(b, a, _twiddles[M-k]);
+        }
+    }
+
+    //! Inverse: numBins/2+1 complex bins in, numBins real samples out
+    void transform(const std::complex<Type> *input, Type *output)
+    {
+        const size_t M = _numBins/2;
+        for (size_t k = 0; k < M; k++)
+        {
+            const auto a = input[k];
+            const auto b = std::conj(input[M-k]);
+            const auto fe = a + b;
+            const auto fo = (a - b)*_twiddles[k];
+            _scratch[k] = fe + std::complex<Type>(-fo.imag(), fo.real());
+        }
+        _fftHalf.transform(_scratch.data(), reinterpret_cast<std::complex<Type> *>(output));
     }
 
 private:
-    kiss_fft_cfg _fftFixed;
+    static inline std::complex<Type> splitBin(const std::complex<Type> &a, const std::complex<Type> &b, const std::complex<Type> &w)
+    {
+        const auto bc = std::conj(b);
+        const auto fe = (a + bc)*Type(0.5);
+        const auto d = (a - bc)*Type(0.5);
+        const std::complex<Type> fo(d.imag(), -d.real()); //divide by j
+        return fe + w*fo;
+    }
+
+    const size_t _numBins;
+    const bool _inverse;
+    FFTAux<std::complex<Type>> _fftHalf;
+    std::vector<std::complex<Type>> _twiddles;
+    std::vector<std::complex<Type>> _scratch;
 };
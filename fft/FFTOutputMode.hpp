@@ -0,0 +1,93 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <Pothos/Exception.hpp>
+#include <complex>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+/***********************************************************************
+ * Spectrum output modes shared by the FFT based blocks:
+ * The complex mode outputs the bins unchanged,
+ * the other modes output a real value per bin.
+ **********************************************************************/
+enum FFTOutputMode
+{
+    FFT_OUTPUT_COMPLEX,
+    FFT_OUTPUT_MAGNITUDE, //|X|
+    FFT_OUTPUT_POWER, //|X|^2
+    FFT_OUTPUT_DB, //10*log10(|X|^2)
+};
+
+static inline FFTOutputMode parseFFTOutputMode(const std::string &mode)
+{
+    if (mode == "COMPLEX") return FFT_OUTPUT_COMPLEX;
+    if (mode == "MAGNITUDE") return FFT_OUTPUT_MAGNITUDE;
+    if (mode == "POWER") return FFT_OUTPUT_POWER;
+    if (mode == "DB") return FFT_OUTPUT_DB;
+    throw Pothos::InvalidArgumentException("parseFFTOutputMode("+mode+")", "unknown output mode");
+}
+
+//! The smallest power used in the dB conversion, avoids -inf for empty bins
+template <typename Type>
+static inline Type fftPowerFloor(void)
+{
+    return Type(1e-20);
+}
+
+/*!
+ * Store f(k) for every bin k at out[(k + offset) % num],
+ * the offset num/2 gives the fftshift ordering.
+ */
+template <typename OutType, typename Fcn>
+static inline void fftStoreShifted(OutType *out, const size_t num, const size_t offset, const Fcn &f)
+{
+    const size_t split = num - offset;
+    for (size_t k = 0; k < split; k++) out[k+offset] = f(k);
+    for (size_t k = split; k < num; k++) out[k-split] = f(k);
+}
+
+//! Apply a real output mode to the power of each bin, power(k) = |X[k]|^2
+template <typename OutType, typename PowerFcn>
+static inline void convertFFTPower(const FFTOutputMode mode, const PowerFcn &power, OutType *out, const size_t num, const size_t offset)
+{
+    switch (mode)
+    {
+    case FFT_OUTPUT_MAGNITUDE:
+        fftStoreShifted(out, num, offset, [&](const size_t k) -> OutType {return std::sqrt(power(k));});
+        break;
+    case FFT_OUTPUT_POWER:
+        fftStoreShifted(out, num, offset, [&](const size_t k) -> OutType {return power(k);});
+        break;
+    case FFT_OUTPUT_DB:
+        fftStoreShifted(out, num, offset, [&](const size_t k) -> OutType {return OutType(10)*std::log10(std::max(power(k), fftPowerFloor<OutType>()));});
+        break;
+    case FFT_OUTPUT_COMPLEX: break;
+    }
+}
+
+/*!
+ * Convert complex bins into one of the real output modes.
+ * The conversion is a single pass so that it can be fused
+ * with the transform output without an extra copy,
+ * and bin k is stored at (k + offset) % num.
+ */
+template <typename InType, typename OutType>
+static inline void convertFFTOutput(const FFTOutputMode mode, const std::complex<InType> *in, OutType *out, const size_t num, const size_t offset = 0)
+{
+    convertFFTPower(mode, [&](const size_t k) -> OutType
+    {
+        const OutType re(in[k].real()), im(in[k].imag());
+        return re*re + im*im;
+    }, out, num, offset);
+}
+
+//! Convert bins from split real and imaginary arrays
+template <typename Type>
+static inline void convertFFTOutput(const FFTOutputMode mode, const Type *re, const Type *im, Type *out, const size_t num, const size_t offset = 0)
+{
+    convertFFTPower(mode, [&](const size_t k) -> Type {return re[k]*re[k] + im[k]*im[k];}, out, num, offset);
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <map>
+#include <utility>
+#include <typeinfo>
+#include <typeindex>
+#include <tuple>
+#include <cstddef>
+
+/***********************************************************************
+ * Process-wide cache of FFT plans (twiddles and factorization).
+ * Plans are keyed by (plan type, size, direction, batch) and are reference
+ * counted: the cache only holds weak references, so a plan lives as
+ * long as at least one FFT user holds it, and identical users share
+ * one instance instead of recomputing twiddles at construction.
+ *
+ * Plan transforms must not modify the plan so that they are safe
+ * to use from multiple threads at once; per-user scratch is kept
+ * by the caller. PlanType is constructed with (nfft, inverse),
+ * or with (nfft, inverse, batch) for batched multi-channel plans.
+ *
+ * This is not a static function: the cache must be one instance
+ * across all translation units in the module, not one per file.
+ **********************************************************************/
+template <typename PlanType>
+std::shared_ptr<PlanType> getCachedFFTPlanImpl(const size_t nfft, const bool inverse, const size_t batch, const std::function<PlanType *(void)> &make)
+{
+    typedef std::tuple<std::type_index, size_t, bool, size_t> KeyType;
+    static std::mutex mutex;
+    static std::map<KeyType, std::weak_ptr<PlanType>> cache;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const KeyType key(typeid(PlanType), nfft, inverse, batch);
+    auto plan = cache[key].lock();
+    if (plan) return plan;
+
+    //remove entries whose plans were released by all users
+    for (auto it = cache.begin(); it != cache.end();)
+    {
+        if (it->second.expired() and it->first != key) it = cache.erase(it);
+        else ++it;
+    }
+
+    //construct under the lock so that concurrent users do not duplicate work
+    plan.reset(make());
+    cache[key] = plan;
+    return plan;
+}
+
+template <typename PlanType>
+std::shared_ptr<PlanType> getCachedFFTPlan(const size_t nfft, const bool inverse)
+{
+    return getCachedFFTPlanImpl<PlanType>(nfft, inverse, 1, [&](void){return new PlanType(nfft, inverse);});
+}
+
+template <typename PlanType>
+std::shared_ptr<PlanType> getCachedFFTPlan(const size_t nfft, const bool inverse, const size_t batch)
+{
+    return getCachedFFTPlanImpl<PlanType>(nfft, inverse, batch, [&](void){return new PlanType(nfft, inverse, batch);});
+}
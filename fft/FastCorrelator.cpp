@@ -0,0 +1,313 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework.hpp>
+#include <complex>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cmath>
+#include <algorithm> //copy
+#include <utility>
+#include "FFTAux.h"
+
+/***********************************************************************
+ * |PothosDoc Fast Correlator
+ *
+ * Correlate input port 0 against a known reference sequence,
+ * and produce the correlation magnitude on output port 0.
+ * The output element n is the correlation of the reference
+ * with the input elements starting at n:
+ * c[n] = sum x[n+m]*conj(ref[m]) / sum |ref[m]|^2,
+ * so an exact copy of the reference in the input produces a magnitude of 1.0.
+ *
+ * The correlation is computed with overlap-save fast convolution:
+ * each FFT of fftSize input elements produces fftSize - len(ref) outputs,
+ * for a cost of O(log(fftSize)) per input element instead of O(len(ref)).
+ * The transforms are shared through the process-wide FFT plan cache.
+ *
+ * <h2>Peak labels</h2>
+ *
+ * A label is posted on the output at every local maximum of the correlation magnitude
+ * that is at or above the threshold. The label index is the index of the peak,
+ * which is also the index of the first input element of the matched reference,
+ * and the label data is the complex correlation value, which includes the phase of the match.
+ *
+ * |category /FFT
+ * |category /Digital
+ * |keywords correlate correlation cross matched filter preamble sounding detect peak fft overlap save
+ *
+ * |param dtype[Data Type] The data type of the input element stream.
+ * Real inputs are correlated as complex with a zero imaginary part.
+ * The output is real with the same precision.
+ * |widget DTypeChooser(float=1, cfloat=1)
+ * |default "complex_float32"
+ * |preview disable
+ *
+ * |param reference[Reference] The known sequence to correlate against.
+ * |default [1.0, 1.0, -1.0, 1.0]
+ *
+ * |param threshold[Threshold] The normalized correlation magnitude to post a peak label.
+ * |default 0.5
+ *
+ * |param peakId[Peak ID] The label ID for correlation peaks.
+ * |default "corrPeak"
+ * |widget StringEntry()
+ * |preview valid
+ *
+ * |param fftSize[FFT Size] The transform size of the overlap-save blocks.
+ * Use 0 to automatically select the smallest power of two that is at least 4 times the reference length.
+ * The size must be larger than the reference length.
+ * |default 0
+ * |preview valid
+ * |tab Advanced
+ *
+ * |param backend[Backend] The FFT implementation used to perform the transforms.
+ * See the /comms/fft block for the available backends.
+ * |default "auto"
+ * |option [Automatic] "auto"
+ * |option [KissFFT] "kissfft"
+ * |option [SIMD] "simd"
+ * |preview disable
+ * |tab Advanced
+ *
+ * |factory /comms/fast_correlator(dtype)
+ * |setter setReference(reference)
+ * |setter setThreshold(threshold)
+ * |setter setPeakId(peakId)
+ * |setter setFFTSize(fftSize)
+ * |setter setBackend(backend)
+ **********************************************************************/
+template <typename InType, typename Type>
+class FastCorrelator : public Pothos::Block
+{
+public:
+    FastCorrelator(void):
+        _threshold(0.5),
+        _fftSizeArg(0),
+        _backend("auto"),
+        _fftSize(0),
+        _blockSize(0),
+        _prevMag(0),
+        _pendingOffset(0),
+        _pendingPeak(0)
+    {
+        this->setupInput(0, typeid(InType));
+        this->setupOutput(0, typeid(Type));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FastCorrelator, setReference));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FastCorrelator, getReference));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FastCorrelator, setThreshold));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FastCorrelator, getThreshold));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FastCorrelator, setPeakId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FastCorrelator, getPeakId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FastCorrelator, setFFTSize));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FastCorrelator, getFFTSize));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FastCorrelator, setBackend));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FastCorrelator, getBackend));
+        this->setPeakId("corrPeak"); //initial update
+        std::vector<std::complex<Type>> reference(4, Type(1));
+        reference[2] = Type(-1);
+        this->setReference(reference); //initial update
+    }
+
+    void setReference(const std::vector<std::complex<Type>> &reference)
+    {
+        if (reference.empty()) throw Pothos::InvalidArgumentException("FastCorrelator::setReference()", "reference cannot be empty");
+        _reference = reference;
+        this->update();
+    }
+
+    std::vector<std::complex<Type>> getReference(void) const
+    {
+        return _reference;
+    }
+
+    void setThreshold(const double threshold)
+    {
+        _threshold = Type(threshold);
+    }
+
+    double getThreshold(void) const
+    {
+        return _threshold;
+    }
+
+    void setPeakId(const std::string &id)
+    {
+        _peakId = id;
+    }
+
+    std::string getPeakId(void) const
+    {
+        return _peakId;
+    }
+
+    void setFFTSize(const size_t fftSize)
+    {
+        _fftSizeArg = fftSize;
+        this->update();
+    }
+
+    //! The transform size in use, after automatic selection
+    size_t getFFTSize(void) const
+    {
+        return _fftSize;
+    }
+
+    void setBackend(const std::string &backend)
+    {
+        if (not isValidFFTBackend(backend)) throw Pothos::InvalidArgumentException("FastCorrelator::setBackend("+backend+")", "unknown backend");
+        _backend = backend;
+        this->update();
+    }
+
+    std::string getBackend(void) const
+    {
+        return _fftForward->backend();
+    }
+
+    //! always use a circular buffer so the overlapping blocks are contiguous
+    Pothos::BufferManager::Sptr getInputBufferManager(const std::string &, const std::string &)
+    {
+        return Pothos::BufferManager::make("circular");
+    }
+
+    /*!
+     * Custom output buffer manager with slabs large enough for an overlap-save block.
+     * The block size may change at runtime, so the outputs of a block
+     * are also produced across multiple output buffers when needed.
+     */
+    Pothos::BufferManager::Sptr getOutputBufferManager(const std::string &, const std::string &)
+    {
+        Pothos::BufferManagerArgs args;
+        args.bufferSize = _blockSize*this->output(0)->dtype().size();
+        return Pothos::BufferManager::make("generic", args);
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        auto outPort = this->output(0);
+
+        size_t consumed = 0, produced = 0;
+        while (true)
+        {
+            //produce the pending outputs of the last block into the available output
+            if (_pendingOffset < _pendingMag.size())
+            {
+                const size_t num = std::min(_pendingMag.size()-_pendingOffset, outPort->elements()-produced);
+                if (num == 0) break;
+                Type *out = outPort->buffer().template as<Type *>() + produced;
+                std::copy(_pendingMag.begin()+_pendingOffset, _pendingMag.begin()+_pendingOffset+num, out);
+                for (; _pendingPeak < _pendingPeaks.size() and _pendingPeaks[_pendingPeak].first < _pendingOffset+num; _pendingPeak++)
+                {
+                    const auto &peak = _pendingPeaks[_pendingPeak];
+                    outPort->postLabel(_peakId, peak.second, produced + peak.first - _pendingOffset);
+                }
+                _pendingOffset += num;
+                produced += num;
+                continue;
+            }
+            if (inPort->elements()-consumed < _fftSize) break;
+
+            //frequency domain correlation against the conjugated reference spectrum
+            const InType *in = inPort->buffer().template as<const InType *>() + consumed;
+            for (size_t n = 0; n < _fftSize; n++) _stage[n] = std::complex<Type>(in[n]);
+            _fftForward->transform(_stage.data(), _spectrum.data());
+            for (size_t k = 0; k < _fftSize; k++) _spectrum[k] *= _refSpectrum[k];
+            _fftInverse->transform(_spectrum.data(), _corr.data());
+
+            //outputs 0 to blockSize-1 are valid, and output blockSize is valid lookahead
+            for (size_t n = 0; n <= _blockSize; n++) _mag[n] = std::abs(_corr[n]);
+            _pendingMag.assign(_mag.begin(), _mag.begin()+_blockSize);
+            _pendingPeaks.clear();
+            for (size_t n = 0; n < _blockSize; n++)
+            {
+                const Type left = (n == 0)?_prevMag:_mag[n-1];
+                if (_mag[n] < _threshold or _mag[n] <= left or _mag[n] < _mag[n+1]) continue;
+                _pendingPeaks.emplace_back(n, _corr[n]);
+            }
+            _prevMag = _mag[_blockSize-1];
+            _pendingOffset = 0;
+            _pendingPeak = 0;
+
+            consumed += _blockSize;
+        }
+
+        if (consumed != 0) inPort->consume(consumed);
+        if (produced != 0) outPort->produce(produced);
+    }
+
+private:
+    void update(void)
+    {
+        const size_t refLen = _reference.size();
+        size_t fftSize = _fftSizeArg;
+        if (fftSize == 0)
+        {
+            fftSize = 1;
+            while (fftSize < 4*refLen) fftSize *= 2;
+        }
+        if (fftSize <= refLen) throw Pothos::InvalidArgumentException("FastCorrelator::setFFTSize()", "FFT size must be larger than the reference length");
+        _fftSize = fftSize;
+        _blockSize = fftSize - refLen;
+
+        //plans are shared with every other block using the same size
+        _fftForward.reset(new FFTAux<std::complex<Type>>(_fftSize, false, _backend));
+        _fftInverse.reset(new FFTAux<std::complex<Type>>(_fftSize, true, _backend));
+
+        //conjugate reference spectrum, normalized by the unscaled inverse and the reference energy
+        double energy = 0.0;
+        for (const auto &r : _reference) energy += std::norm(std::complex<double>(r));
+        _stage.assign(_fftSize, std::complex<Type>(0));
+        std::copy(_reference.begin(), _reference.end(), _stage.begin());
+        _refSpectrum.resize(_fftSize);
+        _fftForward->transform(_stage.data(), _refSpectrum.data());
+        const Type scale(1.0/(energy*_fftSize));
+        for (auto &r : _refSpectrum) r = std::conj(r)*scale;
+
+        _spectrum.resize(_fftSize);
+        _corr.resize(_fftSize);
+        _mag.resize(_blockSize+1);
+        _prevMag = 0;
+        this->input(0)->setReserve(_fftSize);
+    }
+
+    std::vector<std::complex<Type>> _reference;
+    Type _threshold;
+    std::string _peakId;
+    size_t _fftSizeArg;
+    std::string _backend;
+    size_t _fftSize;
+    size_t _blockSize;
+    std::unique_ptr<FFTAux<std::complex<Type>>> _fftForward;
+    std::unique_ptr<FFTAux<std::complex<Type>>> _fftInverse;
+    std::vector<std::complex<Type>> _refSpectrum;
+    std::vector<std::complex<Type>> _stage;
+    std::vector<std::complex<Type>> _spectrum;
+    std::vector<std::complex<Type>> _corr;
+    std::vector<Type> _mag;
+    Type _prevMag;
+
+    //outputs and peaks of the last block that are not yet produced
+    std::vector<Type> _pendingMag;
+    std::vector<std::pair<size_t, std::complex<Type>>> _pendingPeaks;
+    size_t _pendingOffset;
+    size_t _pendingPeak;
+};
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *fastCorrelatorFactory(const Pothos::DType &dtype)
+{
+    #define ifTypeDeclareFactory(Type) \
+        if (dtype == Pothos::DType(typeid(Type))) return new FastCorrelator<Type, Type>(); \
+        if (dtype == Pothos::DType(typeid(std::complex<Type>))) return new FastCorrelator<std::complex<Type>, Type>();
+    ifTypeDeclareFactory(double);
+    ifTypeDeclareFactory(float);
+    throw Pothos::InvalidArgumentException("fastCorrelatorFactory("+dtype.toString()+")", "unsupported type");
+}
+
+static Pothos::BlockRegistry registerFastCorrelator(
+    "/comms/fast_correlator", &fastCorrelatorFactory);
@@ -0,0 +1,145 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include "RadixFFT.hpp" //FFTAlignedVector
+#include "common/ThreadPool.hpp"
+#include <complex>
+#include <vector>
+#include <memory>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+template<typename Type>
+class FFTAux;
+
+/***********************************************************************
+ * Four-step decomposition for large transforms, N = N1*N2:
+ * The input is viewed as an N1 x N2 matrix and transformed with
+ * N2 row transforms of size N1, a twiddle multiply,
+ * and N1 row transforms of size N2, with blocked transposes between
+ * so that every sub-transform runs on contiguous cache-sized rows.
+ * Each step is parallelized over rows using the thread pool,
+ * and every worker owns its own sub-transforms (plans are shared).
+ **********************************************************************/
+template<typename Type>
+class FourStepFFT
+{
+public:
+    FourStepFFT(const size_t nfft, const bool inverse, const size_t numThreads):
+        _n1(factorSize(nfft)),
+        _n2(nfft/_n1),
+        _pool(numThreads),
+        _twHi(_n2),
+        _twLo(_n1),
+        _scratch(nfft)
+    {
+        //W^(q*N1 + r) = twHi[q]*twLo[r], computed in double precision
+        const double phinc = (inverse?2:-2)*std::acos(-1.0)/nfft;
+        for (size_t q = 0; q < _n2; q++) _twHi[q] = std::complex<Type>(std::polar(1.0, phinc*q*_n1));
+        for (size_t r = 0; r < _n1; r++) _twLo[r] = std::complex<Type>(std::polar(1.0, phinc*r));
+
+        for (size_t i = 0; i < _pool.size(); i++)
+        {
+            _fft1.emplace_back(new FFTAux<std::complex<Type>>(_n1, inverse));
+            _fft2.emplace_back(new FFTAux<std::complex<Type>>(_n2, inverse));
+        }
+    }
+
+    //! True when the size has a factorization into two sub-transforms
+    static bool supportsSize(const size_t nfft)
+    {
+        return factorSize(nfft) >= 2;
+    }
+
+    //! The total number of workers used by the transform
+    size_t numThreads(void) const
+    {
+        return _pool.size();
+    }
+
+    //! The input and output must not overlap
+    void transform(const std::complex<Type> *input, std::complex<Type> *output)
+    {
+        std::complex<Type> *scratch = _scratch.data();
+
+        //step 1: N2 row transforms of size N1 over the input columns
+        transpose(input, output, _n1, _n2);
+        _pool.parallelFor(_n2, [&](const size_t worker, const size_t begin, const size_t end)
+        {
+            for (size_t n2 = begin; n2 < end; n2++)
+            {
+                std::complex<Type> *row = scratch + n2*_n1;
+                _fft1[worker]->transform(output + n2*_n1, row);
+
+                //step 2: multiply by W^(n2*k1), stepping the exponent incrementally
+                const size_t dq = n2/_n1, dr = n2%_n1;
+                size_t q = 0, r = 0;
+                for (size_t k1 = 0; k1 < _n1; k1++)
+                {
+                    row[k1] *= _twHi[q]*_twLo[r];
+                    q += dq; r += dr;
+                    if (r >= _n1) {r -= _n1; q++;}
+                }
+            }
+        });
+
+        //step 3: N1 row transforms of size N2
+        transpose(scratch, output, _n2, _n1);
+        _pool.parallelFor(_n1, [&](const size_t worker, const size_t begin, const size_t end)
+        {
+            for (size_t k1 = begin; k1 < end; k1++)
+            {
+                _fft2[worker]->transform(output + k1*_n2, scratch + k1*_n2);
+            }
+        });
+
+        //step 4: the output index is k1 + N1*k2
+        transpose(scratch, output, _n1, _n2);
+    }
+
+private:
+    //! A factor near sqrt(nfft), searching down from the largest power of two not above it
+    static size_t factorSize(const size_t nfft)
+    {
+        size_t n1 = 1;
+        while ((n1*2)*(n1*2) <= nfft) n1 *= 2;
+        for (; n1 >= 2; n1--)
+        {
+            if ((nfft % n1) == 0) return n1;
+        }
+        return 1;
+    }
+
+    //! Blocked transpose of a rows x cols matrix, parallel over destination rows
+    void transpose(const std::complex<Type> *src, std::complex<Type> *dst, const size_t rows, const size_t cols)
+    {
+        static const size_t tile = 32;
+        _pool.parallelFor(cols, [&](const size_t, const size_t begin, const size_t end)
+        {
+            for (size_t c0 = begin; c0 < end; c0 += tile)
+            {
+                const size_t c1 = std::min(c0+tile, end);
+                for (size_t r0 = 0; r0 < rows; r0 += tile)
+                {
+                    const size_t r1 = std::min(r0+tile, rows);
+                    for (size_t c = c0; c < c1; c++)
+                    {
+                        for (size_t r = r0; r < r1; r++) dst[c*rows + r] = src[r*cols + c];
+                    }
+                }
+            }
+        });
+    }
+
+    const size_t _n1;
+    const size_t _n2;
+    CommsCommon::ThreadPool _pool;
+    std::vector<std::complex<Type>> _twHi;
+    std::vector<std::complex<Type>> _twLo;
+    FFTAlignedVector<std::complex<Type>> _scratch;
+    std::vector<std::unique_ptr<FFTAux<std::complex<Type>>>> _fft1;
+    std::vector<std::unique_ptr<FFTAux<std::complex<Type>>>> _fft2;
+};
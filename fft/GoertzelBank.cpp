@@ -0,0 +1,453 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#ifdef POTHOS_XSIMD
+#include "SIMD/FFTBlocks_SIMD.hpp"
+#endif
+
+#include <Pothos/Framework.hpp>
+#include <complex>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm> //min/max/fill
+#include "FFTOutputMode.hpp"
+
+//
+// Implementation getters to be called on class construction
+//
+
+template <typename Type>
+using GoertzelBankUpdateFcn = void(*)(const Type*, const size_t, const Type*, Type*, const size_t);
+
+template <typename Type>
+using SlidingDFTUpdateFcn = void(*)(const Type*, const Type*, const size_t, const Type*, Type*, const size_t);
+
+#ifdef POTHOS_XSIMD
+
+template <typename Type>
+static GoertzelBankUpdateFcn<Type> getGoertzelBankUpdateFcn()
+{
+    return PothosCommsSIMD::goertzelBankUpdateDispatch<Type>();
+}
+
+template <typename Type>
+static SlidingDFTUpdateFcn<Type> getSlidingDFTUpdateFcn()
+{
+    return PothosCommsSIMD::slidingDFTUpdateDispatch<Type>();
+}
+
+#else
+
+template <typename Type>
+static GoertzelBankUpdateFcn<Type> getGoertzelBankUpdateFcn()
+{
+    return [](const Type *in, const size_t numSamples, const Type *coeff, Type *state, const size_t numBins)
+    {
+        Type *s1r = state, *s1i = state+numBins, *s2r = state+2*numBins, *s2i = state+3*numBins;
+        for (size_t k = 0; k < numBins; k++)
+        {
+            for (size_t n = 0; n < numSamples; n++)
+            {
+                const Type r = in[2*n+0] + coeff[k]*s1r[k] - s2r[k];
+                const Type i = in[2*n+1] + coeff[k]*s1i[k] - s2i[k];
+                s2r[k] = s1r[k]; s2i[k] = s1i[k];
+                s1r[k] = r; s1i[k] = i;
+            }
+        }
+    };
+}
+
+template <typename Type>
+static SlidingDFTUpdateFcn<Type> getSlidingDFTUpdateFcn()
+{
+    return [](const Type *in, const Type *old, const size_t numSamples, const Type *tw, Type *state, const size_t numBins)
+    {
+        const Type *rr = tw, *ri = tw+numBins, *tr = tw+2*numBins, *ti = tw+3*numBins;
+        Type *sr = state, *si = state+numBins;
+        for (size_t k = 0; k < numBins; k++)
+        {
+            for (size_t n = 0; n < numSamples; n++)
+            {
+                const Type dr = sr[k] - old[2*n+0], di = si[k] - old[2*n+1];
+                const Type xr = in[2*n+0], xi = in[2*n+1];
+                sr[k] = rr[k]*dr - ri[k]*di + xr*tr[k] - xi*ti[k];
+                si[k] = rr[k]*di + ri[k]*dr + xr*ti[k] + xi*tr[k];
+            }
+        }
+    };
+}
+
+#endif
+
+/***********************************************************************
+ * |PothosDoc Goertzel Bank
+ *
+ * Compute a small bank of DFT bins at arbitrary frequencies on input port 0,
+ * and produce one vector of bins (in the order of the frequency list)
+ * on output port 0 for every decimation input elements.
+ * Each bin is the DFT of the most recent frameLength input elements,
+ * X[k] = sum x[m] exp(-j*2*pi*freq[k]*(m-start)/rate), which matches
+ * the /comms/fft bin when the frequency is an exact multiple of rate/frameLength.
+ * Every bin costs O(1) per input element and no FFT is performed,
+ * which is much cheaper than a full transform when only a handful of bins are needed,
+ * such as for tone detection.
+ *
+ * <h2>Modes</h2>
+ *
+ * <ul>
+ * <li>"BLOCK" runs the Goertzel recursion over a frame for every output,
+ * the cost is O(bins*frameLength/decimation) per input element.</li>
+ * <li>"SLIDING" updates a sliding DFT of the last frameLength elements for every input element,
+ * the cost is O(bins) per input element regardless of the decimation.
+ * The state is recomputed from the frame once per frameLength elements
+ * to bound the error of the recursion.</li>
+ * </ul>
+ *
+ * The recursions are vectorized across bins with SIMD when available,
+ * so the bins of each register are updated together for every input element.
+ *
+ * |category /FFT
+ * |keywords dft goertzel sliding bin tone detect dtmf spectrum
+ *
+ * |param dtype[Data Type] The data type of the input element stream.
+ * Real inputs are processed as complex with a zero imaginary part.
+ * |widget DTypeChooser(float=1, cfloat=1)
+ * |default "complex_float32"
+ * |preview disable
+ *
+ * |param output[Output Mode] The conversion applied to each bin.
+ * The complex mode produces complex elements of the input precision,
+ * the other modes produce real elements.
+ * |option [Complex] "COMPLEX"
+ * |option [Magnitude] "MAGNITUDE"
+ * |option [Power] "POWER"
+ * |option [Power dB] "DB"
+ * |default "POWER"
+ * |preview disable
+ *
+ * |param mode[Mode] The algorithm used to compute the bins.
+ * |option [Block Goertzel] "BLOCK"
+ * |option [Sliding DFT] "SLIDING"
+ * |default "BLOCK"
+ *
+ * |param rate[Sample Rate] The sample rate of the input stream.
+ * |units samples/sec
+ * |default 1.0
+ *
+ * |param freqs[Frequencies] A list of bin frequencies (+/- 0.5*rate).
+ * |units Hz
+ * |default [0.1]
+ *
+ * |param frameLength[Frame Length] The number of input elements in the DFT of each bin.
+ * |default 256
+ * |widget SpinBox(minimum=1)
+ *
+ * |param decimation[Decimation] The number of input elements between consecutive outputs.
+ * In block mode, frames overlap when the decimation is less than the frame length,
+ * and input elements are skipped when the decimation is larger.
+ * |default 256
+ * |widget SpinBox(minimum=1)
+ *
+ * |factory /comms/goertzel_bank(dtype, output)
+ * |setter setMode(mode)
+ * |setter setSampleRate(rate)
+ * |setter setFrequencies(freqs)
+ * |setter setFrameLength(frameLength)
+ * |setter setDecimation(decimation)
+ **********************************************************************/
+template <typename InType, typename Type>
+class GoertzelBank : public Pothos::Block
+{
+public:
+    GoertzelBank(const std::string &output):
+        _outputMode(parseFFTOutputMode(output)),
+        _sliding(false),
+        _rate(1.0),
+        _frameLength(256),
+        _decimation(256),
+        _goertzelUpdate(getGoertzelBankUpdateFcn<Type>()),
+        _slidingUpdate(getSlidingDFTUpdateFcn<Type>()),
+        _primed(false),
+        _sinceSync(0),
+        _untilOutput(0)
+    {
+        this->setupInput(0, typeid(InType));
+        if (_outputMode == FFT_OUTPUT_COMPLEX) this->setupOutput(0, typeid(std::complex<Type>));
+        else this->setupOutput(0, typeid(Type));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GoertzelBank, setMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GoertzelBank, getMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GoertzelBank, setSampleRate));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GoertzelBank, getSampleRate));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GoertzelBank, setFrequencies));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GoertzelBank, getFrequencies));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GoertzelBank, setFrameLength));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GoertzelBank, getFrameLength));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GoertzelBank, setDecimation));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GoertzelBank, getDecimation));
+        this->setFrequencies(std::vector<double>(1, 0.1)); //initial update
+    }
+
+    void setMode(const std::string &mode)
+    {
+        if (mode == "BLOCK") _sliding = false;
+        else if (mode == "SLIDING") _sliding = true;
+        else throw Pothos::InvalidArgumentException("GoertzelBank::setMode("+mode+")", "unknown mode");
+        this->update();
+    }
+
+    std::string getMode(void) const
+    {
+        return _sliding?"SLIDING":"BLOCK";
+    }
+
+    void setSampleRate(const double rate)
+    {
+        if (rate <= 0.0) throw Pothos::InvalidArgumentException("GoertzelBank::setSampleRate()", "sample rate must be positive");
+        _rate = rate;
+        this->update();
+    }
+
+    double getSampleRate(void) const
+    {
+        return _rate;
+    }
+
+    void setFrequencies(const std::vector<double> &freqs)
+    {
+        if (freqs.empty()) throw Pothos::InvalidArgumentException("GoertzelBank::setFrequencies()", "frequency list cannot be empty");
+        _freqs = freqs;
+        this->update();
+    }
+
+    std::vector<double> getFrequencies(void) const
+    {
+        return _freqs;
+    }
+
+    void setFrameLength(const size_t frameLength)
+    {
+        if (frameLength == 0) throw Pothos::InvalidArgumentException("GoertzelBank::setFrameLength()", "frame length cannot be 0");
+        _frameLength = frameLength;
+        this->update();
+    }
+
+    size_t getFrameLength(void) const
+    {
+        return _frameLength;
+    }
+
+    void setDecimation(const size_t decimation)
+    {
+        if (decimation == 0) throw Pothos::InvalidArgumentException("GoertzelBank::setDecimation()", "decimation cannot be 0");
+        _decimation = decimation;
+        this->update();
+    }
+
+    size_t getDecimation(void) const
+    {
+        return _decimation;
+    }
+
+    //! always use a circular buffer so the frame history is contiguous
+    Pothos::BufferManager::Sptr getInputBufferManager(const std::string &, const std::string &)
+    {
+        return Pothos::BufferManager::make("circular");
+    }
+
+    void work(void)
+    {
+        if (_sliding) this->workSliding();
+        else this->workBlock();
+    }
+
+private:
+    void workBlock(void)
+    {
+        auto inPort = this->input(0);
+        auto outPort = this->output(0);
+        const size_t numBins = _freqs.size();
+        const size_t needed = std::max(_frameLength, _decimation);
+
+        size_t consumed = 0, produced = 0;
+        while (inPort->elements()-consumed >= needed and outPort->elements()-produced >= numBins)
+        {
+            this->goertzelFrame(inPort->buffer().template as<const InType *>() + consumed);
+            this->produceBins(produced);
+            produced += numBins;
+            consumed += _decimation;
+        }
+
+        inPort->consume(consumed);
+        outPort->produce(produced);
+    }
+
+    void workSliding(void)
+    {
+        auto inPort = this->input(0);
+        auto outPort = this->output(0);
+        const size_t numBins = _freqs.size();
+        if (inPort->elements() < _frameLength) return;
+
+        //the first frameLength elements of the input buffer are always the current frame
+        size_t consumed = 0, produced = 0;
+        while (true)
+        {
+            const InType *in = inPort->buffer().template as<const InType *>() + consumed;
+            const size_t available = inPort->elements()-consumed-_frameLength;
+
+            //recompute the state from the frame, to start or to bound the recursive error
+            if (not _primed or _sinceSync == _frameLength)
+            {
+                if (not _primed) _untilOutput = 0;
+                this->goertzelFrame(in);
+                _primed = true;
+                _sinceSync = 0;
+            }
+
+            if (_untilOutput == 0)
+            {
+                if (outPort->elements()-produced < numBins) break;
+                this->produceBins(produced);
+                produced += numBins;
+                _untilOutput = _decimation;
+            }
+
+            //slide up to the next output or the next recompute
+            const size_t num = std::min(available, std::min(_untilOutput, _frameLength-_sinceSync));
+            if (num == 0) break;
+            const Type *oldest = this->interleaved(in, num, _stage);
+            const Type *newest = this->interleaved(in+_frameLength, num, _stageNew);
+            _slidingUpdate(newest, oldest, num, _slidingTwiddles.data(), _bins.data(), numBins);
+            consumed += num;
+            _sinceSync += num;
+            _untilOutput -= num;
+        }
+
+        inPort->consume(consumed);
+        outPort->produce(produced);
+    }
+
+    //! Compute the bins of the frame at the input pointer with the Goertzel recursion
+    void goertzelFrame(const InType *in)
+    {
+        const size_t numBins = _freqs.size();
+        std::fill(_state.begin(), _state.end(), Type(0));
+        _goertzelUpdate(this->interleaved(in, _frameLength, _stage), _frameLength, _coeff.data(), _state.data(), numBins);
+
+        //X = exp(-jw(N-1))*s[N-1] - exp(-jwN)*s[N-2]
+        const Type *s1r = _state.data(), *s1i = s1r+numBins, *s2r = s1r+2*numBins, *s2i = s1r+3*numBins;
+        const Type *ar = _twiddles.data(), *ai = ar+numBins, *br = ar+2*numBins, *bi = ar+3*numBins;
+        Type *re = _bins.data(), *im = re+numBins;
+        for (size_t k = 0; k < numBins; k++)
+        {
+            re[k] = ar[k]*s1r[k] - ai[k]*s1i[k] - br[k]*s2r[k] + bi[k]*s2i[k];
+            im[k] = ar[k]*s1i[k] + ai[k]*s1r[k] - br[k]*s2i[k] - bi[k]*s2r[k];
+        }
+    }
+
+    //! Write the current bins at the given output offset
+    void produceBins(const size_t offset)
+    {
+        const size_t numBins = _freqs.size();
+        const Type *re = _bins.data(), *im = re+numBins;
+        if (_outputMode == FFT_OUTPUT_COMPLEX)
+        {
+            auto out = this->output(0)->buffer().template as<std::complex<Type> *>() + offset;
+            for (size_t k = 0; k < numBins; k++) out[k] = std::complex<Type>(re[k], im[k]);
+        }
+        else
+        {
+            auto out = this->output(0)->buffer().template as<Type *>() + offset;
+            convertFFTOutput(_outputMode, re, im, out, numBins);
+        }
+    }
+
+    //! Interleaved view of complex input
+    static const Type *interleaved(const std::complex<Type> *in, const size_t, std::vector<Type> &)
+    {
+        return reinterpret_cast<const Type *>(in);
+    }
+
+    //! Real input is staged as complex with a zero imaginary part
+    static const Type *interleaved(const Type *in, const size_t num, std::vector<Type> &stage)
+    {
+        if (stage.size() < 2*num) stage.resize(2*num);
+        for (size_t n = 0; n < num; n++)
+        {
+            stage[2*n+0] = in[n];
+            stage[2*n+1] = Type(0);
+        }
+        return stage.data();
+    }
+
+    void update(void)
+    {
+        const size_t numBins = _freqs.size();
+        const double N(_frameLength);
+        _coeff.resize(numBins);
+        _twiddles.resize(4*numBins);
+        _slidingTwiddles.resize(4*numBins);
+        for (size_t k = 0; k < numBins; k++)
+        {
+            const double w = 2*std::acos(-1.0)*_freqs[k]/_rate;
+            _coeff[k] = Type(2*std::cos(w));
+
+            //Goertzel output twiddles exp(-jw(N-1)) and exp(-jwN)
+            _twiddles[0*numBins+k] = Type(std::cos(w*(N-1)));
+            _twiddles[1*numBins+k] = Type(-std::sin(w*(N-1)));
+            _twiddles[2*numBins+k] = Type(std::cos(w*N));
+            _twiddles[3*numBins+k] = Type(-std::sin(w*N));
+
+            //sliding rotation exp(jw) and input twiddle exp(-jw(N-1))
+            _slidingTwiddles[0*numBins+k] = Type(std::cos(w));
+            _slidingTwiddles[1*numBins+k] = Type(std::sin(w));
+            _slidingTwiddles[2*numBins+k] = Type(std::cos(w*(N-1)));
+            _slidingTwiddles[3*numBins+k] = Type(-std::sin(w*(N-1)));
+        }
+
+        _bins.assign(2*numBins, Type(0));
+        _state.assign(4*numBins, Type(0));
+        _primed = false;
+        _sinceSync = 0;
+        _untilOutput = 0;
+
+        //sliding mode reads the frame before the next element
+        this->input(0)->setReserve(_sliding?(_frameLength+1):std::max(_frameLength, _decimation));
+    }
+
+    const FFTOutputMode _outputMode;
+    bool _sliding;
+    double _rate;
+    std::vector<double> _freqs;
+    size_t _frameLength;
+    size_t _decimation;
+    GoertzelBankUpdateFcn<Type> _goertzelUpdate;
+    SlidingDFTUpdateFcn<Type> _slidingUpdate;
+    std::vector<Type> _coeff;
+    std::vector<Type> _twiddles;
+    std::vector<Type> _slidingTwiddles;
+    std::vector<Type> _state;
+    std::vector<Type> _bins; //[re | im], also the sliding DFT state
+    std::vector<Type> _stage;
+    std::vector<Type> _stageNew;
+    bool _primed;
+    size_t _sinceSync;
+    size_t _untilOutput;
+};
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *goertzelBankFactory(const Pothos::DType &dtype, const std::string &output)
+{
+    #define ifTypeDeclareFactory(Type) \
+        if (dtype == Pothos::DType(typeid(Type))) return new GoertzelBank<Type, Type>(output); \
+        if (dtype == Pothos::DType(typeid(std::complex<Type>))) return new GoertzelBank<std::complex<Type>, Type>(output);
+    ifTypeDeclareFactory(double);
+    ifTypeDeclareFactory(float);
+    throw Pothos::InvalidArgumentException("goertzelBankFactory("+dtype.toString()+")", "unsupported type");
+}
+
+static Pothos::BlockRegistry registerGoertzelBank(
+    "/comms/goertzel_bank", &goertzelBankFactory);
@@ -0,0 +1,338 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework.hpp>
+#include <complex>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cmath>
+#include <algorithm> //min/max
+#include "FFTAux.h"
+#include "OFDMHelper.hpp"
+
+/***********************************************************************
+ * |PothosDoc OFDM Demodulator
+ *
+ * Demodulate a stream of OFDM symbols on input port 0
+ * into the data symbols on output port 0 and the received pilots on output port 1.
+ * Every OFDM symbol consumes fftSize + cyclic prefix elements,
+ * discards the cyclic prefix, performs a forward FFT of the remaining elements,
+ * and extracts the data carriers and pilot carriers in the order of their lists.
+ * The received pilots are available to downstream channel estimation and equalization.
+ * Consecutive OFDM symbols are transformed together in one batched FFT
+ * (up to 16 symbols and 4096 points per batch).
+ *
+ * The transform is scaled by 1/sqrt(fftSize), so that the output reproduces
+ * the input of the /comms/ofdm_mod block with the same configuration.
+ *
+ * <h2>Symbol alignment</h2>
+ *
+ * The demodulator starts at the first input element and steps through the input
+ * one OFDM symbol at a time. An input label with the symbol start ID realigns the
+ * demodulator: elements before the label are dropped, and the next OFDM symbol starts
+ * at the label. Upstream timing synchronization or the labels of the /comms/ofdm_mod block
+ * can be used to mark the symbol boundaries.
+ *
+ * A label with the symbol start ID marks the first data symbol of every OFDM symbol
+ * on output port 0 and the first pilot of every OFDM symbol on output port 1.
+ * The label data is the count of OFDM symbols demodulated before it.
+ *
+ * |category /FFT
+ * |category /Modulation
+ * |keywords ofdm demodulator subcarrier carrier cyclic prefix pilot fft multicarrier
+ *
+ * |param dtype[Data Type] The data type of the input stream and the symbols.
+ * |widget DTypeChooser(cfloat=1)
+ * |default "complex_float32"
+ * |preview disable
+ *
+ * |param fftSize[FFT Size] The number of subcarriers.
+ * |default 64
+ * |option 64
+ * |option 128
+ * |option 256
+ * |option 512
+ * |option 1024
+ * |widget ComboBox(editable=true)
+ *
+ * |param cpLength[Cyclic Prefix] The number of cyclic prefix elements per OFDM symbol.
+ * |default 16
+ * |widget SpinBox(minimum=0)
+ *
+ * |param dataCarriers[Data Carriers] A list of subcarrier indexes for the data symbols,
+ * where the indexes are in the range [-fftSize/2, fftSize/2) and 0 is DC.
+ * Use an empty list for every carrier except DC and the pilot carriers.
+ * |default []
+ *
+ * |param pilotCarriers[Pilot Carriers] A list of subcarrier indexes for the pilots.
+ * |default []
+ *
+ * |param symbolStartId[Symbol Start ID] The label ID that marks the start of each OFDM symbol.
+ * |default "symStart"
+ * |widget StringEntry()
+ * |preview valid
+ *
+ * |param backend[Backend] The FFT implementation used to perform the transform.
+ * See the /comms/fft block for the available backends.
+ * |default "auto"
+ * |option [Automatic] "auto"
+ * |option [KissFFT] "kissfft"
+ * |option [SIMD] "simd"
+ * |preview disable
+ * |tab Advanced
+ *
+ * |factory /comms/ofdm_demod(dtype, fftSize)
+ * |setter setCyclicPrefix(cpLength)
+ * |setter setDataCarriers(dataCarriers)
+ * |setter setPilotCarriers(pilotCarriers)
+ * |setter setSymbolStartId(symbolStartId)
+ * |setter setBackend(backend)
+ **********************************************************************/
+template <typename Type>
+class OFDMDemod : public Pothos::Block
+{
+public:
+    OFDMDemod(const size_t fftSize):
+        _fftSize(fftSize),
+        _cpLength(16),
+        _scale(Type(1.0/std::sqrt(double(fftSize)))),
+        _freq(fftSize),
+        _batch(ofdmBatchSize(fftSize)),
+        _batchTime(fftSize*_batch),
+        _batchFreq(fftSize*_batch),
+        _symbolCount(0)
+    {
+        this->setupInput(0, typeid(std::complex<Type>));
+        this->setupOutput(0, typeid(std::complex<Type>));
+        this->setupOutput(1, typeid(std::complex<Type>));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMDemod, setCyclicPrefix));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMDemod, getCyclicPrefix));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMDemod, setDataCarriers));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMDemod, getDataCarriers));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMDemod, setPilotCarriers));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMDemod, getPilotCarriers));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMDemod, setSymbolStartId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMDemod, getSymbolStartId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMDemod, setBackend));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMDemod, getBackend));
+        this->setSymbolStartId("symStart"); //initial update
+        this->setBackend("auto"); //initial update
+        this->update(); //initial update
+    }
+
+    void setCyclicPrefix(const size_t cpLength)
+    {
+        if (cpLength > _fftSize) throw Pothos::InvalidArgumentException("OFDMDemod::setCyclicPrefix()", "cyclic prefix longer than the FFT size");
+        _cpLength = cpLength;
+        this->update();
+    }
+
+    size_t getCyclicPrefix(void) const
+    {
+        return _cpLength;
+    }
+
+    void setDataCarriers(const std::vector<int> &carriers)
+    {
+        _dataCarriers = carriers;
+        this->update();
+    }
+
+    std::vector<int> getDataCarriers(void) const
+    {
+        return _dataCarriers;
+    }
+
+    void setPilotCarriers(const std::vector<int> &carriers)
+    {
+        _pilotCarriers = carriers;
+        this->update();
+    }
+
+    std::vector<int> getPilotCarriers(void) const
+    {
+        return _pilotCarriers;
+    }
+
+    void setSymbolStartId(const std::string &id)
+    {
+        _symbolStartId = id;
+    }
+
+    std::string getSymbolStartId(void) const
+    {
+        return _symbolStartId;
+    }
+
+    void setBackend(const std::string &backend)
+    {
+        if (not isValidFFTBackend(backend)) throw Pothos::InvalidArgumentException("OFDMDemod::setBackend("+backend+")", "unknown backend");
+        _fftAux.reset(new FFTAux<std::complex<Type>>(_fftSize, false, backend));
+        if (_batch > 1) _fftAuxBatch.reset(new FFTAux<std::complex<Type>>(_fftSize, false, backend, 1, _batch));
+    }
+
+    std::string getBackend(void) const
+    {
+        return _fftAux->backend();
+    }
+
+    //! always use a circular buffer so every OFDM symbol is contiguous, large enough for a batch
+    Pothos::BufferManager::Sptr getInputBufferManager(const std::string &, const std::string &)
+    {
+        Pothos::BufferManagerArgs args;
+        args.bufferSize = std::max(args.bufferSize, 2*_fftSize*_batch*this->input(0)->dtype().size());
+        return Pothos::BufferManager::make("circular", args);
+    }
+
+    //! Custom output buffer manager with slabs large enough for a batch of OFDM symbols
+    Pothos::BufferManager::Sptr getOutputBufferManager(const std::string &, const std::string &)
+    {
+        Pothos::BufferManagerArgs args;
+        args.bufferSize = std::max(args.bufferSize, _fftSize*_batch*this->output(0)->dtype().size());
+        return Pothos::BufferManager::make("generic", args);
+    }
+
+    void activate(void)
+    {
+        _symbolCount = 0;
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        auto dataPort = this->output(0);
+        auto pilotPort = this->output(1);
+        const size_t numData = _dataBins.size();
+        const size_t numPilots = _pilotBins.size();
+        const size_t symbolLength = _fftSize + _cpLength;
+
+        const auto in = inPort->buffer().template as<const std::complex<Type> *>();
+        const auto data = dataPort->buffer().template as<std::complex<Type> *>();
+        const auto pilots = pilotPort->buffer().template as<std::complex<Type> *>();
+        const size_t maxSymbols = std::min(
+            dataPort->elements()/numData,
+            (numPilots == 0)?dataPort->elements():(pilotPort->elements()/numPilots));
+
+        //find the input offset of every OFDM symbol that fits in this call
+        _symbolOffsets.clear();
+        size_t consumed = 0;
+        while (inPort->elements()-consumed >= symbolLength and _symbolOffsets.size() < maxSymbols)
+        {
+            //realign on a symbol start label inside the next OFDM symbol
+            size_t realign = 0;
+            for (const auto &label : inPort->labels())
+            {
+                if (label.id != _symbolStartId) continue;
+                if (label.index <= consumed or label.index >= consumed+symbolLength) continue;
+                realign = label.index - consumed;
+                break;
+            }
+            if (realign != 0)
+            {
+                consumed += realign;
+                continue;
+            }
+            _symbolOffsets.push_back(consumed);
+            consumed += symbolLength;
+        }
+
+        //transform after the cyclic prefix, the output of the FFT is the subcarriers,
+        //a batch of symbols is transformed together with the symbols interleaved in the batch
+        size_t producedData = 0, producedPilots = 0;
+        for (size_t s = 0; s < _symbolOffsets.size();)
+        {
+            const size_t B = (_symbolOffsets.size()-s >= _batch)?_batch:1;
+            const std::complex<Type> *freq = _freq.data();
+            if (B > 1)
+            {
+                for (size_t c = 0; c < B; c++)
+                {
+                    const auto symbol = in + _symbolOffsets[s+c] + _cpLength;
+                    for (size_t n = 0; n < _fftSize; n++) _batchTime[n*B+c] = symbol[n];
+                }
+                _fftAuxBatch->transform(_batchTime.data(), _batchFreq.data());
+                freq = _batchFreq.data();
+            }
+            else _fftAux->transform(in + _symbolOffsets[s] + _cpLength, _freq.data());
+
+            for (size_t c = 0; c < B; c++)
+            {
+                for (size_t i = 0; i < numData; i++) data[producedData+i] = freq[_dataBins[i]*B+c]*_scale;
+                for (size_t i = 0; i < numPilots; i++) pilots[producedPilots+i] = freq[_pilotBins[i]*B+c]*_scale;
+
+                dataPort->postLabel(_symbolStartId, _symbolCount, producedData);
+                if (numPilots != 0) pilotPort->postLabel(_symbolStartId, _symbolCount, producedPilots);
+                _symbolCount++;
+
+                producedData += numData;
+                producedPilots += numPilots;
+            }
+            s += B;
+        }
+
+        inPort->consume(consumed);
+        dataPort->produce(producedData);
+        pilotPort->produce(producedPilots);
+    }
+
+    void propagateLabels(const Pothos::InputPort *port)
+    {
+        //symbol start labels are consumed by the alignment, other labels move to the data of their symbol:
+        //the first symbol transformed in the last work call that ends after the label,
+        //or the next symbol for a label after the last transformed symbol
+        auto dataPort = this->output(0);
+        const size_t symbolLength = _fftSize + _cpLength;
+        for (const auto &label : port->labels())
+        {
+            if (label.id == _symbolStartId) continue;
+            size_t symbol = 0;
+            while (symbol < _symbolOffsets.size() and _symbolOffsets[symbol]+symbolLength <= label.index) symbol++;
+            auto newLabel = label;
+            newLabel.index = symbol*_dataBins.size();
+            newLabel.width = 1;
+            dataPort->postLabel(newLabel);
+        }
+    }
+
+private:
+    void update(void)
+    {
+        buildOFDMCarrierMap(_fftSize, _dataCarriers, _pilotCarriers, _dataBins, _pilotBins);
+        this->input(0)->setReserve(_fftSize + _cpLength);
+    }
+
+    const size_t _fftSize;
+    size_t _cpLength;
+    std::vector<int> _dataCarriers;
+    std::vector<int> _pilotCarriers;
+    std::string _symbolStartId;
+    const Type _scale;
+    std::vector<size_t> _dataBins;
+    std::vector<size_t> _pilotBins;
+    std::vector<std::complex<Type>> _freq;
+    const size_t _batch; //OFDM symbols per batched transform
+    std::vector<std::complex<Type>> _batchTime; //interleaved input symbols of the batch
+    std::vector<std::complex<Type>> _batchFreq; //interleaved subcarriers of the batch
+    std::vector<size_t> _symbolOffsets; //input offsets of the symbols in a work call, used to map labels
+    unsigned long long _symbolCount;
+    std::unique_ptr<FFTAux<std::complex<Type>>> _fftAux;
+    std::unique_ptr<FFTAux<std::complex<Type>>> _fftAuxBatch;
+};
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *ofdmDemodFactory(const Pothos::DType &dtype, const size_t fftSize)
+{
+    if (fftSize < 2) throw Pothos::InvalidArgumentException("ofdmDemodFactory()", "FFT size must be at least 2");
+
+    #define ifTypeDeclareFactory(Type) \
+        if (dtype == Pothos::DType(typeid(std::complex<Type>))) return new OFDMDemod<Type>(fftSize);
+    ifTypeDeclareFactory(double);
+    ifTypeDeclareFactory(float);
+    throw Pothos::InvalidArgumentException("ofdmDemodFactory("+dtype.toString()+")", "unsupported type");
+}
+
+static Pothos::BlockRegistry registerOFDMDemod(
+    "/comms/ofdm_demod", &ofdmDemodFactory);
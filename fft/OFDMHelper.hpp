@@ -0,0 +1,59 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <Pothos/Exception.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <algorithm> //find/min/max
+
+/***********************************************************************
+ * Map the signed subcarrier indexes of the OFDM blocks to FFT bins:
+ * carrier k in [-fftSize/2, fftSize/2) is bin (k + fftSize) % fftSize.
+ * An empty data carrier list selects every carrier except DC and the pilots.
+ **********************************************************************/
+static inline void buildOFDMCarrierMap(
+    const size_t fftSize,
+    const std::vector<int> &dataCarriers,
+    const std::vector<int> &pilotCarriers,
+    std::vector<size_t> &dataBins,
+    std::vector<size_t> &pilotBins)
+{
+    const int half = int(fftSize/2);
+    std::vector<bool> used(fftSize, false);
+    const auto toBin = [&](const int carrier) -> size_t
+    {
+        if (carrier < -half or carrier >= int(fftSize)-half) throw Pothos::RangeException(
+            "buildOFDMCarrierMap("+std::to_string(carrier)+")", "carrier index outside of the FFT");
+        const size_t bin = size_t(carrier + int(fftSize)) % fftSize;
+        if (used[bin]) throw Pothos::InvalidArgumentException(
+            "buildOFDMCarrierMap("+std::to_string(carrier)+")", "carrier index used more than once");
+        used[bin] = true;
+        return bin;
+    };
+
+    pilotBins.clear();
+    for (const auto carrier : pilotCarriers) pilotBins.push_back(toBin(carrier));
+
+    dataBins.clear();
+    for (const auto carrier : dataCarriers) dataBins.push_back(toBin(carrier));
+    if (dataCarriers.empty()) for (int carrier = -half; carrier < int(fftSize)-half; carrier++)
+    {
+        if (carrier == 0) continue;
+        if (std::find(pilotCarriers.begin(), pilotCarriers.end(), carrier) != pilotCarriers.end()) continue;
+        dataBins.push_back(toBin(carrier));
+    }
+    if (dataBins.empty()) throw Pothos::InvalidArgumentException("buildOFDMCarrierMap()", "no data carriers");
+}
+
+/***********************************************************************
+ * The OFDM blocks transform several OFDM symbols in one batched FFT,
+ * with the symbols interleaved as the channels of the batch:
+ * up to 16 symbols and 4096 points per batch, and no batch for large FFTs.
+ **********************************************************************/
+static inline size_t ofdmBatchSize(const size_t fftSize)
+{
+    return std::max<size_t>(1, std::min<size_t>(16, 4096/fftSize));
+}
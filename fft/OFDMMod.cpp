@@ -0,0 +1,312 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework.hpp>
+#include <complex>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cmath>
+#include <algorithm> //copy/fill
+#include "FFTAux.h"
+#include "OFDMHelper.hpp"
+
+/***********************************************************************
+ * |PothosDoc OFDM Modulator
+ *
+ * Modulate a stream of data symbols on input port 0 into OFDM symbols on output port 0.
+ * Every OFDM symbol consumes one data symbol per data carrier,
+ * maps the data symbols and the pilot values onto their subcarriers,
+ * performs an inverse FFT, and copies the end of the symbol in front of it as the cyclic prefix.
+ * Unused subcarriers are zero.
+ * Consecutive OFDM symbols are transformed together in one batched FFT
+ * (up to 16 symbols and 4096 points per batch),
+ * and the remaining symbols of a work call are transformed one at a time
+ * directly into the output buffer.
+ *
+ * The transform is scaled by 1/sqrt(fftSize), so that the /comms/ofdm_demod block
+ * with the same configuration reproduces the input symbols.
+ *
+ * A label marks the first element (the start of the cyclic prefix) of every OFDM symbol,
+ * and the label data is the count of OFDM symbols produced before it.
+ *
+ * |category /FFT
+ * |category /Modulation
+ * |keywords ofdm modulator subcarrier carrier cyclic prefix pilot ifft multicarrier
+ *
+ * |param dtype[Data Type] The data type of the symbols and the output stream.
+ * |widget DTypeChooser(cfloat=1)
+ * |default "complex_float32"
+ * |preview disable
+ *
+ * |param fftSize[FFT Size] The number of subcarriers.
+ * |default 64
+ * |option 64
+ * |option 128
+ * |option 256
+ * |option 512
+ * |option 1024
+ * |widget ComboBox(editable=true)
+ *
+ * |param cpLength[Cyclic Prefix] The number of cyclic prefix elements per OFDM symbol.
+ * |default 16
+ * |widget SpinBox(minimum=0)
+ *
+ * |param dataCarriers[Data Carriers] A list of subcarrier indexes for the data symbols,
+ * where the indexes are in the range [-fftSize/2, fftSize/2) and 0 is DC.
+ * The data symbols are mapped onto the carriers in the order of the list.
+ * Use an empty list for every carrier except DC and the pilot carriers.
+ * |default []
+ *
+ * |param pilotCarriers[Pilot Carriers] A list of subcarrier indexes for the pilots.
+ * |default []
+ *
+ * |param pilotValues[Pilot Values] The pilot symbols in the order of the pilot carriers.
+ * The list is repeated when it is shorter than the list of pilot carriers.
+ * |default [1.0]
+ *
+ * |param symbolStartId[Symbol Start ID] The label ID that marks the start of each OFDM symbol.
+ * |default "symStart"
+ * |widget StringEntry()
+ * |preview valid
+ *
+ * |param backend[Backend] The FFT implementation used to perform the transform.
+ * See the /comms/fft block for the available backends.
+ * |default "auto"
+ * |option [Automatic] "auto"
+ * |option [KissFFT] "kissfft"
+ * |option [SIMD] "simd"
+ * |preview disable
+ * |tab Advanced
+ *
+ * |factory /comms/ofdm_mod(dtype, fftSize)
+ * |setter setCyclicPrefix(cpLength)
+ * |setter setDataCarriers(dataCarriers)
+ * |setter setPilotCarriers(pilotCarriers)
+ * |setter setPilotValues(pilotValues)
+ * |setter setSymbolStartId(symbolStartId)
+ * |setter setBackend(backend)
+ **********************************************************************/
+template <typename Type>
+class OFDMMod : public Pothos::Block
+{
+public:
+    OFDMMod(const size_t fftSize):
+        _fftSize(fftSize),
+        _cpLength(16),
+        _pilotValues(1, std::complex<Type>(1)),
+        _scale(Type(1.0/std::sqrt(double(fftSize)))),
+        _freq(fftSize),
+        _batch(ofdmBatchSize(fftSize)),
+        _batchFreq(fftSize*_batch),
+        _batchTime(fftSize*_batch),
+        _symbolCount(0)
+    {
+        this->setupInput(0, typeid(std::complex<Type>));
+        this->setupOutput(0, typeid(std::complex<Type>));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMMod, setCyclicPrefix));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMMod, getCyclicPrefix));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMMod, setDataCarriers));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMMod, getDataCarriers));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMMod, setPilotCarriers));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMMod, getPilotCarriers));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMMod, setPilotValues));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMMod, getPilotValues));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMMod, setSymbolStartId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMMod, getSymbolStartId));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMMod, setBackend));
+        this->registerCall(this, POTHOS_FCN_TUPLE(OFDMMod, getBackend));
+        this->setSymbolStartId("symStart"); //initial update
+        this->setBackend("auto"); //initial update
+        this->update(); //initial update
+    }
+
+    void setCyclicPrefix(const size_t cpLength)
+    {
+        if (cpLength > _fftSize) throw Pothos::InvalidArgumentException("OFDMMod::setCyclicPrefix()", "cyclic prefix longer than the FFT size");
+        _cpLength = cpLength;
+    }
+
+    size_t getCyclicPrefix(void) const
+    {
+        return _cpLength;
+    }
+
+    void setDataCarriers(const std::vector<int> &carriers)
+    {
+        _dataCarriers = carriers;
+        this->update();
+    }
+
+    std::vector<int> getDataCarriers(void) const
+    {
+        return _dataCarriers;
+    }
+
+    void setPilotCarriers(const std::vector<int> &carriers)
+    {
+        _pilotCarriers = carriers;
+        this->update();
+    }
+
+    std::vector<int> getPilotCarriers(void) const
+    {
+        return _pilotCarriers;
+    }
+
+    void setPilotValues(const std::vector<std::complex<Type>> &values)
+    {
+        if (values.empty()) throw Pothos::InvalidArgumentException("OFDMMod::setPilotValues()", "pilot values cannot be empty");
+        _pilotValues = values;
+    }
+
+    std::vector<std::complex<Type>> getPilotValues(void) const
+    {
+        return _pilotValues;
+    }
+
+    void setSymbolStartId(const std::string &id)
+    {
+        _symbolStartId = id;
+    }
+
+    std::string getSymbolStartId(void) const
+    {
+        return _symbolStartId;
+    }
+
+    void setBackend(const std::string &backend)
+    {
+        if (not isValidFFTBackend(backend)) throw Pothos::InvalidArgumentException("OFDMMod::setBackend("+backend+")", "unknown backend");
+        _fftAux.reset(new FFTAux<std::complex<Type>>(_fftSize, true, backend));
+        if (_batch > 1) _fftAuxBatch.reset(new FFTAux<std::complex<Type>>(_fftSize, true, backend, 1, _batch));
+    }
+
+    std::string getBackend(void) const
+    {
+        return _fftAux->backend();
+    }
+
+    //! Custom output buffer manager with slabs large enough for a batch of OFDM symbols
+    Pothos::BufferManager::Sptr getOutputBufferManager(const std::string &, const std::string &)
+    {
+        Pothos::BufferManagerArgs args;
+        args.bufferSize = std::max(args.bufferSize, 2*_fftSize*_batch*this->output(0)->dtype().size());
+        return Pothos::BufferManager::make("generic", args);
+    }
+
+    void activate(void)
+    {
+        _symbolCount = 0;
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        auto outPort = this->output(0);
+        const size_t numData = _dataBins.size();
+        const size_t symbolLength = _fftSize + _cpLength;
+
+        const auto in = inPort->buffer().template as<const std::complex<Type> *>();
+        const auto out = outPort->buffer().template as<std::complex<Type> *>();
+        const size_t numSymbols = std::min(inPort->elements()/numData, outPort->elements()/symbolLength);
+        size_t consumed = 0, produced = 0;
+        for (size_t s = 0; s < numSymbols;)
+        {
+            //transform a batch of symbols together, with the symbols interleaved in the batch
+            const size_t B = (numSymbols-s >= _batch)?_batch:1;
+            if (B > 1)
+            {
+                for (size_t c = 0; c < B; c++)
+                {
+                    for (size_t i = 0; i < numData; i++) _batchFreq[_dataBins[i]*B+c] = in[consumed+c*numData+i]*_scale;
+                    for (size_t i = 0; i < _pilotBins.size(); i++) _batchFreq[_pilotBins[i]*B+c] = _pilotValues[i % _pilotValues.size()]*_scale;
+                }
+                _fftAuxBatch->transform(_batchFreq.data(), _batchTime.data());
+                for (size_t c = 0; c < B; c++)
+                {
+                    std::complex<Type> *symbol = out + produced + c*symbolLength;
+                    for (size_t n = 0; n < _fftSize; n++) symbol[_cpLength+n] = _batchTime[n*B+c];
+                }
+            }
+
+            //map the data and pilots onto the subcarriers, and transform into the output after the prefix
+            else
+            {
+                for (size_t i = 0; i < numData; i++) _freq[_dataBins[i]] = in[consumed+i]*_scale;
+                for (size_t i = 0; i < _pilotBins.size(); i++) _freq[_pilotBins[i]] = _pilotValues[i % _pilotValues.size()]*_scale;
+                _fftAux->transform(_freq.data(), out + produced + _cpLength);
+            }
+
+            //copy the end of each symbol into the prefix
+            for (size_t c = 0; c < B; c++)
+            {
+                std::complex<Type> *symbol = out + produced;
+                std::copy(symbol + _fftSize, symbol + symbolLength, symbol);
+                outPort->postLabel(_symbolStartId, _symbolCount++, produced);
+                consumed += numData;
+                produced += symbolLength;
+            }
+            s += B;
+        }
+
+        inPort->consume(consumed);
+        outPort->produce(produced);
+    }
+
+    void propagateLabels(const Pothos::InputPort *port)
+    {
+        //input labels move to the start of the OFDM symbol that carries their data symbol
+        auto outPort = this->output(0);
+        for (const auto &label : port->labels())
+        {
+            auto newLabel = label;
+            newLabel.index = (label.index/_dataBins.size())*(_fftSize + _cpLength);
+            newLabel.width = 1;
+            outPort->postLabel(newLabel);
+        }
+    }
+
+private:
+    void update(void)
+    {
+        buildOFDMCarrierMap(_fftSize, _dataCarriers, _pilotCarriers, _dataBins, _pilotBins);
+        std::fill(_freq.begin(), _freq.end(), std::complex<Type>(0));
+        std::fill(_batchFreq.begin(), _batchFreq.end(), std::complex<Type>(0));
+        this->input(0)->setReserve(_dataBins.size());
+    }
+
+    const size_t _fftSize;
+    size_t _cpLength;
+    std::vector<int> _dataCarriers;
+    std::vector<int> _pilotCarriers;
+    std::vector<std::complex<Type>> _pilotValues;
+    std::string _symbolStartId;
+    const Type _scale;
+    std::vector<size_t> _dataBins;
+    std::vector<size_t> _pilotBins;
+    std::vector<std::complex<Type>> _freq;
+    const size_t _batch; //OFDM symbols per batched transform
+    std::vector<std::complex<Type>> _batchFreq; //interleaved subcarriers of the batch
+    std::vector<std::complex<Type>> _batchTime; //interleaved transforms of the batch
+    unsigned long long _symbolCount;
+    std::unique_ptr<FFTAux<std::complex<Type>>> _fftAux;
+    std::unique_ptr<FFTAux<std::complex<Type>>> _fftAuxBatch;
+};
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *ofdmModFactory(const Pothos::DType &dtype, const size_t fftSize)
+{
+    if (fftSize < 2) throw Pothos::InvalidArgumentException("ofdmModFactory()", "FFT size must be at least 2");
+
+    #define ifTypeDeclareFactory(Type) \
+        if (dtype == Pothos::DType(typeid(std::complex<Type>))) return new OFDMMod<Type>(fftSize);
+    ifTypeDeclareFactory(double);
+    ifTypeDeclareFactory(float);
+    throw Pothos::InvalidArgumentException("ofdmModFactory("+dtype.toString()+")", "unsupported type");
+}
+
+static Pothos::BlockRegistry registerOFDMMod(
+    "/comms/ofdm_mod", &ofdmModFactory);
@@ -0,0 +1,329 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework.hpp>
+#include <complex>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cmath>
+#include <algorithm> //fill
+#include "FFTAux.h"
+#include "PFBPrototype.hpp"
+
+/***********************************************************************
+ * |PothosDoc PFB Channelizer
+ *
+ * Split the input stream into numChannels equally spaced channels
+ * with a polyphase analysis filter bank.
+ * Channel k is centered at k*rate/numChannels (channels above numChannels/2
+ * are the negative frequencies), and is the input frequency translated to baseband,
+ * low pass filtered by the prototype filter, and decimated.
+ *
+ * The prototype filter is split into numChannels polyphase branches,
+ * and one numChannels-point FFT of the branch outputs produces
+ * one output element on every channel, for a cost of
+ * O(tapsPerChannel + log(numChannels)) per input element,
+ * instead of one frequency translating filter per channel.
+ *
+ * <h2>Modes</h2>
+ *
+ * <ul>
+ * <li>"CRITICAL" decimates by numChannels, so every channel is sampled at rate/numChannels.
+ * The channel edges alias into their neighbors by the transition band of the prototype.</li>
+ * <li>"OVERSAMPLED" decimates by numChannels/2, so every channel is sampled at 2*rate/numChannels,
+ * and the full channel bandwidth is free of aliasing (requires an even number of channels).</li>
+ * </ul>
+ *
+ * <h2>Output layout</h2>
+ *
+ * The "PORTS" layout produces channel k on output port k.
+ * The "VECTOR" layout produces a single output port with a dimension of numChannels,
+ * where every output element holds one sample of every channel in channel order.
+ *
+ * |category /FFT
+ * |category /Filter
+ * |keywords pfb polyphase filter bank channelizer analysis channel split fft
+ *
+ * |param dtype[Data Type] The data type of the input element stream.
+ * Real inputs are processed as complex with a zero imaginary part.
+ * The channels are complex with the same precision.
+ * |widget DTypeChooser(float=1, cfloat=1)
+ * |default "complex_float32"
+ * |preview disable
+ *
+ * |param numChannels[Num Channels] The number of channels.
+ * |default 8
+ * |widget SpinBox(minimum=2)
+ * |preview disable
+ *
+ * |param layout[Output Layout] Produce the channels on separate ports or as a vector stream.
+ * |option [Ports] "PORTS"
+ * |option [Vector] "VECTOR"
+ * |default "PORTS"
+ * |preview disable
+ *
+ * |param mode[Mode] The channel sample rate.
+ * |option [Critically Sampled] "CRITICAL"
+ * |option [2x Oversampled] "OVERSAMPLED"
+ * |default "CRITICAL"
+ *
+ * |param tapsPerChannel[Taps Per Channel] The length of each polyphase branch.
+ * The prototype filter has numChannels*tapsPerChannel taps,
+ * longer branches produce a sharper transition at the channel edges.
+ * |default 16
+ * |widget SpinBox(minimum=1)
+ *
+ * |param window[Window Type] The window function of the prototype filter.
+ * |default "blackman"
+ * |option [Rectangular] "rectangular"
+ * |option [Hann] "hann"
+ * |option [Hamming] "hamming"
+ * |option [Blackman] "blackman"
+ * |option [Bartlett] "bartlett"
+ * |option [Flat-top] "flattop"
+ * |option [Kaiser] "kaiser"
+ * |option [Chebyshev] "chebyshev"
+ * |tab Prototype
+ *
+ * |param windowArgs[Window Args] Optional window arguments (depends on window type).
+ * <ul>
+ * <li>When using the <i>Kaiser</i> window, specify [beta] to use the parameterized Kaiser window.</li>
+ * <li>When using the <i>Chebyshev</i> window, specify [atten] to use the Dolph-Chebyshev window with attenuation in dB.</li>
+ * </ul>
+ * |default []
+ * |preview valid
+ * |tab Prototype
+ *
+ * |param backend[Backend] The FFT implementation used to perform the transform.
+ * See the /comms/fft block for the available backends.
+ * |default "auto"
+ * |option [Automatic] "auto"
+ * |option [KissFFT] "kissfft"
+ * |option [SIMD] "simd"
+ * |preview disable
+ * |tab Advanced
+ *
+ * |factory /comms/pfb_channelizer(dtype, numChannels, layout)
+ * |setter setMode(mode)
+ * |setter setTapsPerChannel(tapsPerChannel)
+ * |setter setWindowType(window)
+ * |setter setWindowArgs(windowArgs)
+ * |setter setBackend(backend)
+ **********************************************************************/
+template <typename InType, typename Type>
+class PFBChannelizer : public Pothos::Block
+{
+public:
+    PFBChannelizer(const size_t numChannels, const bool vectorLayout):
+        _numChannels(numChannels),
+        _vectorLayout(vectorLayout),
+        _decim(numChannels),
+        _tapsPerChannel(16),
+        _windowType("blackman"),
+        _backend("auto"),
+        _branches(numChannels),
+        _channels(numChannels),
+        _rotation(numChannels),
+        _phase(0)
+    {
+        this->setupInput(0, typeid(InType));
+        if (_vectorLayout) this->setupOutput(0, Pothos::DType(typeid(std::complex<Type>), numChannels));
+        else for (size_t k = 0; k < numChannels; k++) this->setupOutput(k, typeid(std::complex<Type>));
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBChannelizer, setMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBChannelizer, getMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBChannelizer, setTapsPerChannel));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBChannelizer, getTapsPerChannel));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBChannelizer, setWindowType));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBChannelizer, getWindowType));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBChannelizer, setWindowArgs));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBChannelizer, getWindowArgs));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBChannelizer, setBackend));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBChannelizer, getBackend));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBChannelizer, getPrototype));
+
+        //the final rotation is exp(-j*2*pi*k*q/numChannels)
+        for (size_t q = 0; q < numChannels; q++)
+        {
+            _rotation[q] = std::complex<Type>(std::polar(1.0, -2*std::acos(-1.0)*q/numChannels));
+        }
+
+        this->setBackend("auto"); //initial update
+        this->recalculatePrototype(); //initial update
+    }
+
+    void setMode(const std::string &mode)
+    {
+        if (mode == "CRITICAL") _decim = _numChannels;
+        else if (mode == "OVERSAMPLED")
+        {
+            if ((_numChannels % 2) != 0) throw Pothos::InvalidArgumentException("PFBChannelizer::setMode("+mode+")", "oversampling requires an even number of channels");
+            _decim = _numChannels/2;
+        }
+        else throw Pothos::InvalidArgumentException("PFBChannelizer::setMode("+mode+")", "unknown mode");
+    }
+
+    std::string getMode(void) const
+    {
+        return (_decim == _numChannels)?"CRITICAL":"OVERSAMPLED";
+    }
+
+    void setTapsPerChannel(const size_t tapsPerChannel)
+    {
+        if (tapsPerChannel == 0) throw Pothos::InvalidArgumentException("PFBChannelizer::setTapsPerChannel()", "taps per channel cannot be 0");
+        _tapsPerChannel = tapsPerChannel;
+        this->recalculatePrototype();
+    }
+
+    size_t getTapsPerChannel(void) const
+    {
+        return _tapsPerChannel;
+    }
+
+    void setWindowType(const std::string &type)
+    {
+        _windowType = type;
+        this->recalculatePrototype();
+    }
+
+    std::string getWindowType(void) const
+    {
+        return _windowType;
+    }
+
+    void setWindowArgs(const std::vector<double> &args)
+    {
+        _windowArgs = args;
+        this->recalculatePrototype();
+    }
+
+    std::vector<double> getWindowArgs(void) const
+    {
+        return _windowArgs;
+    }
+
+    void setBackend(const std::string &backend)
+    {
+        if (not isValidFFTBackend(backend)) throw Pothos::InvalidArgumentException("PFBChannelizer::setBackend("+backend+")", "unknown backend");
+        _backend = backend;
+        _fftAux.reset(new FFTAux<std::complex<Type>>(_numChannels, false, _backend));
+    }
+
+    std::string getBackend(void) const
+    {
+        return _fftAux->backend();
+    }
+
+    //! The prototype filter taps in use
+    std::vector<double> getPrototype(void) const
+    {
+        return _prototype;
+    }
+
+    //! always use a circular buffer so the filter history is contiguous
+    Pothos::BufferManager::Sptr getInputBufferManager(const std::string &, const std::string &)
+    {
+        return Pothos::BufferManager::make("circular");
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        const size_t numTaps = _taps.size();
+        const size_t numOut = this->workInfo().minOutElements;
+
+        size_t consumed = 0, produced = 0;
+        while (inPort->elements()-consumed >= numTaps and produced < numOut)
+        {
+            //polyphase branches over the reversed taps, the newest element is last
+            const InType *in = inPort->buffer().template as<const InType *>() + consumed;
+            std::fill(_branches.begin(), _branches.end(), std::complex<Type>(0));
+            for (size_t p = 0; p < _tapsPerChannel; p++)
+            {
+                const Type *taps = _taps.data() + p*_numChannels;
+                const InType *x = in + (_tapsPerChannel-1-p)*_numChannels;
+                for (size_t s = 0; s < _numChannels; s++) _branches[s] += std::complex<Type>(x[s])*taps[s];
+            }
+            _fftAux->transform(_branches.data(), _channels.data());
+
+            //rotate each channel by its carrier phase at the newest element
+            for (size_t k = 0, q = 0; k < _numChannels; k++, q = (q + _phase) % _numChannels)
+            {
+                const auto y = _channels[k]*_rotation[q];
+                if (_vectorLayout) this->output(0)->buffer().template as<std::complex<Type> *>()[produced*_numChannels + k] = y;
+                else this->output(k)->buffer().template as<std::complex<Type> *>()[produced] = y;
+            }
+
+            _phase = (_phase + _decim) % _numChannels;
+            consumed += _decim;
+            produced++;
+        }
+
+        inPort->consume(consumed);
+        for (auto outPort : this->outputs()) outPort->produce(produced);
+    }
+
+    void propagateLabels(const Pothos::InputPort *port)
+    {
+        for (const auto &label : port->labels())
+        {
+            for (auto outPort : this->outputs()) outPort->postLabel(label.toAdjusted(1, _decim));
+        }
+    }
+
+private:
+    void recalculatePrototype(void)
+    {
+        _prototype = designPFBPrototype(_numChannels, _tapsPerChannel, _windowType, _windowArgs);
+
+        //branch p holds taps h[p*M + M-1-s], so every branch is a contiguous product with the input,
+        //and the reversal contributes exp(-j*2*pi*k/M) to the rotation of the newest element;
+        //the frame length is a multiple of M, so the phase only depends on the consumed elements
+        const size_t numTaps = _prototype.size();
+        _taps.resize(numTaps);
+        for (size_t p = 0; p < _tapsPerChannel; p++)
+        {
+            for (size_t s = 0; s < _numChannels; s++)
+            {
+                _taps[p*_numChannels + s] = Type(_prototype[p*_numChannels + _numChannels-1-s]);
+            }
+        }
+        this->input(0)->setReserve(numTaps);
+    }
+
+    const size_t _numChannels;
+    const bool _vectorLayout;
+    size_t _decim;
+    size_t _tapsPerChannel;
+    std::string _windowType;
+    std::vector<double> _windowArgs;
+    std::string _backend;
+    std::vector<double> _prototype;
+    std::vector<Type> _taps;
+    std::vector<std::complex<Type>> _branches;
+    std::vector<std::complex<Type>> _channels;
+    std::vector<std::complex<Type>> _rotation;
+    size_t _phase;
+    std::unique_ptr<FFTAux<std::complex<Type>>> _fftAux;
+};
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *pfbChannelizerFactory(const Pothos::DType &dtype, const size_t numChannels, const std::string &layout)
+{
+    if (numChannels < 2) throw Pothos::InvalidArgumentException("pfbChannelizerFactory()", "at least 2 channels required");
+    if (layout != "PORTS" and layout != "VECTOR") throw Pothos::InvalidArgumentException("pfbChannelizerFactory("+layout+")", "unknown output layout");
+    const bool vectorLayout = (layout == "VECTOR");
+
+    #define ifTypeDeclareFactory(Type) \
+        if (dtype == Pothos::DType(typeid(Type))) return new PFBChannelizer<Type, Type>(numChannels, vectorLayout); \
+        if (dtype == Pothos::DType(typeid(std::complex<Type>))) return new PFBChannelizer<std::complex<Type>, Type>(numChannels, vectorLayout);
+    ifTypeDeclareFactory(double);
+    ifTypeDeclareFactory(float);
+    throw Pothos::InvalidArgumentException("pfbChannelizerFactory("+dtype.toString()+")", "unsupported type");
+}
+
+static Pothos::BlockRegistry registerPFBChannelizer(
+    "/comms/pfb_channelizer", &pfbChannelizerFactory);
@@ -0,0 +1,50 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <Pothos/Exception.hpp>
+#include <spuce/filters/design_fir.h>
+#include <spuce/filters/design_window.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/***********************************************************************
+ * Prototype low pass filter for the polyphase filter banks:
+ * numChannels*tapsPerChannel taps with a cutoff of half a channel spacing,
+ * designed with the same spuce sinc and window calls as the FIR designer,
+ * and normalized for unity gain at DC.
+ **********************************************************************/
+static inline std::vector<double> designPFBPrototype(
+    const size_t numChannels,
+    const size_t tapsPerChannel,
+    const std::string &windowType,
+    const std::vector<double> &windowArgs)
+{
+    const size_t numTaps = numChannels*tapsPerChannel;
+    std::vector<double> taps;
+    try
+    {
+        taps = spuce::design_fir("sinc", "LOW_PASS", int(numTaps), float(0.5/numChannels), 0.0f);
+    }
+    catch (const std::runtime_error &error)
+    {
+        throw Pothos::InvalidArgumentException("designPFBPrototype()", error.what());
+    }
+
+    const auto window = spuce::design_window(windowType, int(numTaps), windowArgs.empty()?0.0:windowArgs.at(0));
+    if (window.size() != numTaps or taps.size() != numTaps)
+    {
+        throw Pothos::InvalidArgumentException("designPFBPrototype("+windowType+")", "unknown window type");
+    }
+
+    double sum = 0.0;
+    for (size_t i = 0; i < numTaps; i++)
+    {
+        taps[i] *= window[i];
+        sum += taps[i];
+    }
+    for (auto &tap : taps) tap /= sum;
+    return taps;
+}
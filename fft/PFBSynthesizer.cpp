@@ -0,0 +1,336 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework.hpp>
+#include <complex>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <algorithm> //min/fill
+#include "FFTAux.h"
+#include "PFBPrototype.hpp"
+
+/***********************************************************************
+ * |PothosDoc PFB Synthesizer
+ *
+ * Combine numChannels narrowband channels into one wideband stream
+ * with a polyphase synthesis filter bank, the mirror of the /comms/pfb_channelizer.
+ * Every channel is interpolated by numChannels with the prototype filter,
+ * and translated from baseband to k*rate/numChannels (channels above numChannels/2
+ * are the negative frequencies), where rate is the output sample rate.
+ * A unit amplitude tone in a channel has unit amplitude in the output.
+ *
+ * One inverse FFT of the channel samples and the polyphase branches
+ * produce numChannels output elements, for a cost of
+ * O(tapsPerChannel + log(numChannels)) per output element,
+ * instead of one interpolator and frequency translation per channel.
+ *
+ * <h2>Input layout</h2>
+ *
+ * The "PORTS" layout consumes channel k on input port k.
+ * The channels are consumed in lockstep: the block waits for every port
+ * that is not idle, so a channel that arrives late stays aligned with the others.
+ * A port without input for the idle timeout (including unconnected ports)
+ * is idle and treated as zeros, so idle channels never stall the other channels.
+ * An idle port becomes active again once input arrives.
+ * The "VECTOR" layout consumes a single input port with a dimension of numChannels,
+ * where every input element holds one sample of every channel in channel order.
+ *
+ * |category /FFT
+ * |category /Filter
+ * |keywords pfb polyphase filter bank synthesizer synthesis combiner channel fft transmit
+ *
+ * |param dtype[Data Type] The data type of the channels and the output stream.
+ * |widget DTypeChooser(cfloat=1)
+ * |default "complex_float32"
+ * |preview disable
+ *
+ * |param numChannels[Num Channels] The number of channels.
+ * |default 8
+ * |widget SpinBox(minimum=2)
+ * |preview disable
+ *
+ * |param layout[Input Layout] Consume the channels on separate ports or as a vector stream.
+ * |option [Ports] "PORTS"
+ * |option [Vector] "VECTOR"
+ * |default "PORTS"
+ * |preview disable
+ *
+ * |param tapsPerChannel[Taps Per Channel] The length of each polyphase branch.
+ * The prototype filter has numChannels*tapsPerChannel taps,
+ * longer branches produce a sharper transition at the channel edges.
+ * |default 16
+ * |widget SpinBox(minimum=1)
+ *
+ * |param window[Window Type] The window function of the prototype filter.
+ * |default "blackman"
+ * |option [Rectangular] "rectangular"
+ * |option [Hann] "hann"
+ * |option [Hamming] "hamming"
+ * |option [Blackman] "blackman"
+ * |option [Bartlett] "bartlett"
+ * |option [Flat-top] "flattop"
+ * |option [Kaiser] "kaiser"
+ * |option [Chebyshev] "chebyshev"
+ * |tab Prototype
+ *
+ * |param windowArgs[Window Args] Optional window arguments (depends on window type).
+ * <ul>
+ * <li>When using the <i>Kaiser</i> window, specify [beta] to use the parameterized Kaiser window.</li>
+ * <li>When using the <i>Chebyshev</i> window, specify [atten] to use the Dolph-Chebyshev window with attenuation in dB.</li>
+ * </ul>
+ * |default []
+ * |preview valid
+ * |tab Prototype
+ *
+ * |param idleTimeout[Idle Timeout] The time without input after which a port is idle, in seconds.
+ * Idle ports are treated as zeros in the "PORTS" layout.
+ * |default 0.1
+ * |units seconds
+ * |preview disable
+ * |tab Advanced
+ *
+ * |param backend[Backend] The FFT implementation used to perform the transform.
+ * See the /comms/fft block for the available backends.
+ * |default "auto"
+ * |option [Automatic] "auto"
+ * |option [KissFFT] "kissfft"
+ * |option [SIMD] "simd"
+ * |preview disable
+ * |tab Advanced
+ *
+ * |factory /comms/pfb_synthesizer(dtype, numChannels, layout)
+ * |setter setTapsPerChannel(tapsPerChannel)
+ * |setter setWindowType(window)
+ * |setter setWindowArgs(windowArgs)
+ * |setter setBackend(backend)
+ * |setter setIdleTimeout(idleTimeout)
+ **********************************************************************/
+template <typename Type>
+class PFBSynthesizer : public Pothos::Block
+{
+public:
+    PFBSynthesizer(const size_t numChannels, const bool vectorLayout):
+        _numChannels(numChannels),
+        _vectorLayout(vectorLayout),
+        _tapsPerChannel(16),
+        _windowType("blackman"),
+        _backend("auto"),
+        _channels(numChannels),
+        _head(0),
+        _lastInputTime(vectorLayout?1:numChannels)
+    {
+        if (_vectorLayout) this->setupInput(0, Pothos::DType(typeid(std::complex<Type>), numChannels));
+        else for (size_t k = 0; k < numChannels; k++) this->setupInput(k, typeid(std::complex<Type>));
+        this->setupOutput(0, typeid(std::complex<Type>));
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBSynthesizer, setTapsPerChannel));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBSynthesizer, getTapsPerChannel));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBSynthesizer, setWindowType));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBSynthesizer, getWindowType));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBSynthesizer, setWindowArgs));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBSynthesizer, getWindowArgs));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBSynthesizer, setBackend));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBSynthesizer, getBackend));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBSynthesizer, getPrototype));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBSynthesizer, setIdleTimeout));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PFBSynthesizer, getIdleTimeout));
+        this->setBackend("auto"); //initial update
+        this->setIdleTimeout(0.1); //initial update
+        this->recalculatePrototype(); //initial update
+    }
+
+    void setTapsPerChannel(const size_t tapsPerChannel)
+    {
+        if (tapsPerChannel == 0) throw Pothos::InvalidArgumentException("PFBSynthesizer::setTapsPerChannel()", "taps per channel cannot be 0");
+        _tapsPerChannel = tapsPerChannel;
+        this->recalculatePrototype();
+    }
+
+    size_t getTapsPerChannel(void) const
+    {
+        return _tapsPerChannel;
+    }
+
+    void setWindowType(const std::string &type)
+    {
+        _windowType = type;
+        this->recalculatePrototype();
+    }
+
+    std::string getWindowType(void) const
+    {
+        return _windowType;
+    }
+
+    void setWindowArgs(const std::vector<double> &args)
+    {
+        _windowArgs = args;
+        this->recalculatePrototype();
+    }
+
+    std::vector<double> getWindowArgs(void) const
+    {
+        return _windowArgs;
+    }
+
+    void setBackend(const std::string &backend)
+    {
+        if (not isValidFFTBackend(backend)) throw Pothos::InvalidArgumentException("PFBSynthesizer::setBackend("+backend+")", "unknown backend");
+        _backend = backend;
+        _fftAux.reset(new FFTAux<std::complex<Type>>(_numChannels, true, _backend));
+    }
+
+    std::string getBackend(void) const
+    {
+        return _fftAux->backend();
+    }
+
+    void setIdleTimeout(const double timeout)
+    {
+        if (timeout < 0) throw Pothos::InvalidArgumentException("PFBSynthesizer::setIdleTimeout()", "idle timeout cannot be negative");
+        _idleTimeoutSecs = timeout;
+        _idleTimeout = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::nanoseconds((long long)(timeout*1e9)));
+    }
+
+    double getIdleTimeout(void) const
+    {
+        return _idleTimeoutSecs;
+    }
+
+    //! The prototype filter taps in use (before the interpolation gain)
+    std::vector<double> getPrototype(void) const
+    {
+        return _prototype;
+    }
+
+    //! Custom output buffer manager with slabs large enough for at least one transform
+    Pothos::BufferManager::Sptr getOutputBufferManager(const std::string &, const std::string &)
+    {
+        Pothos::BufferManagerArgs args;
+        args.bufferSize = std::max(args.bufferSize, _numChannels*this->output(0)->dtype().size());
+        return Pothos::BufferManager::make("generic", args);
+    }
+
+    //! Every port starts the idle timeout on activation, so unconnected ports become idle
+    void activate(void)
+    {
+        std::fill(_lastInputTime.begin(), _lastInputTime.end(), std::chrono::high_resolution_clock::now());
+    }
+
+    void work(void)
+    {
+        auto outPort = this->output(0);
+
+        //the number of channel samples over the ports that are not idle,
+        //ports without input for the idle timeout are treated as zeros
+        const auto timeNow = std::chrono::high_resolution_clock::now();
+        size_t num = outPort->elements()/_numChannels;
+        bool anyInput = false, waiting = false;
+        for (auto inPort : this->inputs())
+        {
+            const size_t elems = inPort->elements();
+            if (elems != 0) _lastInputTime[inPort->index()] = timeNow;
+            else if (timeNow - _lastInputTime[inPort->index()] > _idleTimeout) continue;
+            else waiting = true;
+            anyInput = anyInput or (elems != 0);
+            num = std::min(num, elems);
+        }
+
+        //wait for the late ports, and call work again to check the idle timeout
+        if (waiting and anyInput) this->yield();
+        if (num == 0 or not anyInput) return;
+
+        auto out = outPort->buffer().template as<std::complex<Type> *>();
+        for (size_t m = 0; m < num; m++)
+        {
+            //gather one sample of every channel
+            if (_vectorLayout)
+            {
+                const auto in = this->input(0)->buffer().template as<const std::complex<Type> *>() + m*_numChannels;
+                std::copy(in, in+_numChannels, _channels.begin());
+            }
+            else for (size_t k = 0; k < _numChannels; k++)
+            {
+                auto inPort = this->input(k);
+                _channels[k] = (inPort->elements() == 0)?std::complex<Type>(0):inPort->buffer().template as<const std::complex<Type> *>()[m];
+            }
+
+            //the newest transform replaces the oldest entry of the branch history
+            _head = (_head == 0)?(_tapsPerChannel-1):(_head-1);
+            _fftAux->transform(_channels.data(), _history.data() + _head*_numChannels);
+
+            //output element r of the block is sum over p of g[p*M + r]*V[m-p][r]
+            std::complex<Type> *y = out + m*_numChannels;
+            std::fill(y, y+_numChannels, std::complex<Type>(0));
+            for (size_t p = 0; p < _tapsPerChannel; p++)
+            {
+                const Type *taps = _taps.data() + p*_numChannels;
+                const std::complex<Type> *v = _history.data() + ((_head + p) % _tapsPerChannel)*_numChannels;
+                for (size_t r = 0; r < _numChannels; r++) y[r] += v[r]*taps[r];
+            }
+        }
+
+        for (auto inPort : this->inputs())
+        {
+            if (inPort->elements() != 0) inPort->consume(num);
+        }
+        outPort->produce(num*_numChannels);
+    }
+
+    void propagateLabels(const Pothos::InputPort *port)
+    {
+        auto outPort = this->output(0);
+        for (const auto &label : port->labels())
+        {
+            outPort->postLabel(label.toAdjusted(_numChannels, 1));
+        }
+    }
+
+private:
+    void recalculatePrototype(void)
+    {
+        //the interpolation gain numChannels keeps unit amplitude per channel
+        _prototype = designPFBPrototype(_numChannels, _tapsPerChannel, _windowType, _windowArgs);
+        _taps.resize(_prototype.size());
+        for (size_t i = 0; i < _prototype.size(); i++) _taps[i] = Type(_prototype[i]*_numChannels);
+        _history.assign(_prototype.size(), std::complex<Type>(0));
+        _head = 0;
+    }
+
+    const size_t _numChannels;
+    const bool _vectorLayout;
+    size_t _tapsPerChannel;
+    std::string _windowType;
+    std::vector<double> _windowArgs;
+    std::string _backend;
+    std::vector<double> _prototype;
+    std::vector<Type> _taps;
+    std::vector<std::complex<Type>> _channels;
+    std::vector<std::complex<Type>> _history; //tapsPerChannel transforms of numChannels
+    size_t _head;
+    std::vector<std::chrono::high_resolution_clock::time_point> _lastInputTime; //per input port
+    double _idleTimeoutSecs;
+    std::chrono::high_resolution_clock::duration _idleTimeout;
+    std::unique_ptr<FFTAux<std::complex<Type>>> _fftAux;
+};
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *pfbSynthesizerFactory(const Pothos::DType &dtype, const size_t numChannels, const std::string &layout)
+{
+    if (numChannels < 2) throw Pothos::InvalidArgumentException("pfbSynthesizerFactory()", "at least 2 channels required");
+    if (layout != "PORTS" and layout != "VECTOR") throw Pothos::InvalidArgumentException("pfbSynthesizerFactory("+layout+")", "unknown input layout");
+    const bool vectorLayout = (layout == "VECTOR");
+
+    #define ifTypeDeclareFactory(Type) \
+        if (dtype == Pothos::DType(typeid(std::complex<Type>))) return new PFBSynthesizer<Type>(numChannels, vectorLayout);
+    ifTypeDeclareFactory(double);
+    ifTypeDeclareFactory(float);
+    throw Pothos::InvalidArgumentException("pfbSynthesizerFactory("+dtype.toString()+")", "unsupported type");
+}
+
+static Pothos::BlockRegistry registerPFBSynthesizer(
+    "/comms/pfb_synthesizer", &pfbSynthesizerFactory);
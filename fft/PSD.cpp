@@ -0,0 +1,396 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#ifdef POTHOS_XSIMD
+#include "SIMD/FFTBlocks_SIMD.hpp"
+#endif
+
+#include <Pothos/Framework.hpp>
+#include <complex>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <cmath>
+#include <algorithm> //max/fill
+#include <spuce/filters/design_window.h>
+#include "FFTAux.h"
+#include "FFTOutputMode.hpp"
+
+using spuce::design_window;
+
+//
+// Implementation getters to be called on class construction
+//
+
+template <typename Type>
+using AccumulateSquaresFcn = void(*)(const Type*, Type*, const size_t);
+
+#ifdef POTHOS_XSIMD
+
+template <typename Type>
+static AccumulateSquaresFcn<Type> getAccumulateSquaresFcn()
+{
+    return PothosCommsSIMD::fftAccumulateSquaresDispatch<Type>();
+}
+
+#else
+
+template <typename Type>
+static AccumulateSquaresFcn<Type> getAccumulateSquaresFcn()
+{
+    return [](const Type *in, Type *acc, const size_t num)
+    {
+        for (size_t i = 0; i < num; i++) acc[i] += in[i]*in[i];
+    };
+}
+
+#endif
+
+/***********************************************************************
+ * |PothosDoc PSD
+ *
+ * Estimate the power spectral density of input port 0 with Welch's method,
+ * and produce one averaged spectrum of numBins elements on output port 0
+ * for every averaging interval.
+ *
+ * Windowed frames are read from a circular input buffer every hop elements,
+ * so consecutive frames may overlap. The power of every frame is accumulated
+ * in place, and the averaged result is only produced once per interval,
+ * so the output rate is decoupled from the input rate.
+ * The accumulation does not allocate, and uses SIMD when available.
+ *
+ * The output is normalized by the number of frames and by the window power,
+ * out[k] = sum |X[k]|^2 / (numFrames * sum w[n]^2),
+ * and the optional dB output is 10*log10(out[k]).
+ *
+ * |category /FFT
+ * |keywords psd power spectral density welch average spectrum periodogram
+ *
+ * |param dtype[Data Type] The data type of the input element stream.
+ * Real inputs are transformed as complex with a zero imaginary part.
+ * The output is real with the same precision.
+ * |widget DTypeChooser(float=1, cfloat=1)
+ * |default "complex_float32"
+ * |preview disable
+ *
+ * |param numBins[Num FFT Bins] The number of bins per fourier transform.
+ * |default 1024
+ * |option 512
+ * |option 1024
+ * |option 2048
+ * |option 4096
+ * |widget ComboBox(editable=true)
+ *
+ * |param hop[Hop Size] The number of input elements between consecutive frames.
+ * Use half of the number of bins for the typical 50% overlap.
+ * |default 512
+ * |widget SpinBox(minimum=1)
+ *
+ * |param numAverages[Num Averages] The number of frames averaged per output.
+ * Only used when the interval is 0.
+ * |default 16
+ * |widget SpinBox(minimum=1)
+ *
+ * |param interval[Interval] The time in seconds between averaged outputs.
+ * All frames that arrive within the interval are averaged.
+ * A special value of 0.0 averages a fixed number of frames instead.
+ * |units seconds
+ * |default 0.0
+ * |preview valid
+ *
+ * |param output[Output Mode] The scale of the averaged spectrum.
+ * |option [Power] "POWER"
+ * |option [Power dB] "DB"
+ * |default "DB"
+ *
+ * |param window[Window Type] The window function applied to each frame.
+ * |default "hann"
+ * |option [Rectangular] "rectangular"
+ * |option [Hann] "hann"
+ * |option [Hamming] "hamming"
+ * |option [Blackman] "blackman"
+ * |option [Bartlett] "bartlett"
+ * |option [Flat-top] "flattop"
+ * |option [Kaiser] "kaiser"
+ * |option [Chebyshev] "chebyshev"
+ *
+ * |param windowArgs[Window Args] Optional window arguments (depends on window type).
+ * <ul>
+ * <li>When using the <i>Kaiser</i> window, specify [beta] to use the parameterized Kaiser window.</li>
+ * <li>When using the <i>Chebyshev</i> window, specify [atten] to use the Dolph-Chebyshev window with attenuation in dB.</li>
+ * </ul>
+ * |default []
+ * |preview valid
+ *
+ * |param backend[Backend] The FFT implementation used to perform the transform.
+ * See the /comms/fft block for the available backends.
+ * |default "auto"
+ * |option [Automatic] "auto"
+ * |option [KissFFT] "kissfft"
+ * |option [SIMD] "simd"
+ * |option [Four Step] "fourstep"
+ * |preview disable
+ * |tab Advanced
+ *
+ * |factory /comms/psd(dtype, numBins)
+ * |setter setHopSize(hop)
+ * |setter setNumAverages(numAverages)
+ * |setter setInterval(interval)
+ * |setter setOutputMode(output)
+ * |setter setWindowType(window)
+ * |setter setWindowArgs(windowArgs)
+ * |setter setBackend(backend)
+ **********************************************************************/
+template <typename InType, typename Type>
+class PSD : public Pothos::Block
+{
+public:
+    PSD(const size_t numBins):
+        _numBins(numBins),
+        _hop(512),
+        _numAverages(16),
+        _interval(0.0),
+        _outputMode(FFT_OUTPUT_DB),
+        _windowType("hann"),
+        _windowPower(1.0),
+        _stage(numBins),
+        _spectrum(numBins),
+        _accumulator(2*numBins),
+        _numFrames(0)
+    {
+        this->setupInput(0, typeid(InType));
+        this->setupOutput(0, typeid(Type));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PSD, setHopSize));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PSD, getHopSize));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PSD, setNumAverages));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PSD, getNumAverages));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PSD, setInterval));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PSD, getInterval));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PSD, setOutputMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PSD, getOutputMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PSD, setWindowType));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PSD, getWindowType));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PSD, setWindowArgs));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PSD, getWindowArgs));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PSD, setBackend));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PSD, getBackend));
+        this->setHopSize(512); //initial update
+        this->setBackend("auto"); //initial update
+        this->recalculateWindow(); //initial update
+    }
+
+    void setHopSize(const size_t hop)
+    {
+        if (hop == 0) throw Pothos::InvalidArgumentException("PSD::setHopSize()", "hop size cannot be 0");
+        _hop = hop;
+        this->input(0)->setReserve(std::max(_numBins, _hop));
+    }
+
+    size_t getHopSize(void) const
+    {
+        return _hop;
+    }
+
+    void setNumAverages(const size_t numAverages)
+    {
+        if (numAverages == 0) throw Pothos::InvalidArgumentException("PSD::setNumAverages()", "num averages cannot be 0");
+        _numAverages = numAverages;
+    }
+
+    size_t getNumAverages(void) const
+    {
+        return _numAverages;
+    }
+
+    void setInterval(const double interval)
+    {
+        if (interval < 0.0) throw Pothos::InvalidArgumentException("PSD::setInterval()", "interval cannot be negative");
+        _interval = interval;
+        _nextOutput = std::chrono::high_resolution_clock::now() + this->intervalDuration();
+    }
+
+    double getInterval(void) const
+    {
+        return _interval;
+    }
+
+    void setOutputMode(const std::string &output)
+    {
+        const auto mode = parseFFTOutputMode(output);
+        if (mode != FFT_OUTPUT_POWER and mode != FFT_OUTPUT_DB) throw Pothos::InvalidArgumentException("PSD::setOutputMode("+output+")", "unsupported output mode");
+        _outputMode = mode;
+    }
+
+    std::string getOutputMode(void) const
+    {
+        return (_outputMode == FFT_OUTPUT_DB)?"DB":"POWER";
+    }
+
+    void setWindowType(const std::string &type)
+    {
+        _windowType = type;
+        this->recalculateWindow();
+    }
+
+    std::string getWindowType(void) const
+    {
+        return _windowType;
+    }
+
+    void setWindowArgs(const std::vector<double> &args)
+    {
+        _windowArgs = args;
+        this->recalculateWindow();
+    }
+
+    std::vector<double> getWindowArgs(void) const
+    {
+        return _windowArgs;
+    }
+
+    void setBackend(const std::string &backend)
+    {
+        if (not isValidFFTBackend(backend)) throw Pothos::InvalidArgumentException("PSD::setBackend("+backend+")", "unknown backend");
+        _fftAux.reset(new FFTAux<std::complex<Type>>(_numBins, false, backend));
+    }
+
+    std::string getBackend(void) const
+    {
+        return _fftAux->backend();
+    }
+
+    //! always use a circular buffer so overlapping frames are contiguous
+    Pothos::BufferManager::Sptr getInputBufferManager(const std::string &, const std::string &)
+    {
+        return Pothos::BufferManager::make("circular");
+    }
+
+    //! Custom output buffer manager with slabs large enough for the spectrum
+    Pothos::BufferManager::Sptr getOutputBufferManager(const std::string &, const std::string &)
+    {
+        Pothos::BufferManagerArgs args;
+        args.bufferSize = _numBins*sizeof(Type);
+        return Pothos::BufferManager::make("generic", args);
+    }
+
+    void activate(void)
+    {
+        this->resetAccumulator();
+        _nextOutput = std::chrono::high_resolution_clock::now() + this->intervalDuration();
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        auto outPort = this->output(0);
+
+        //accumulate the power of every available frame
+        const size_t frameRequire = std::max(_numBins, _hop);
+        const InType *in = inPort->buffer();
+        size_t offset = 0;
+        while (inPort->elements() - offset >= frameRequire)
+        {
+            //in frame count mode, stop once the average is complete
+            if (_interval == 0.0 and _numFrames >= _numAverages) break;
+
+            for (size_t n = 0; n < _numBins; n++)
+            {
+                _stage[n] = std::complex<Type>(in[offset+n])*_window[n];
+            }
+            _fftAux->transform(_stage.data(), _spectrum.data());
+            _accumulateSquares(reinterpret_cast<const Type *>(_spectrum.data()), _accumulator.data(), _accumulator.size());
+            _numFrames++;
+            offset += _hop;
+        }
+        inPort->consume(offset);
+
+        //produce the average once per interval
+        if (_numFrames == 0) return;
+        if (_interval > 0.0)
+        {
+            if (std::chrono::high_resolution_clock::now() < _nextOutput) return;
+        }
+        else if (_numFrames < _numAverages) return;
+        if (outPort->elements() < _numBins) return;
+
+        Type *out = outPort->buffer();
+        const Type scale = Type(1.0/(_numFrames*_windowPower));
+        for (size_t k = 0; k < _numBins; k++)
+        {
+            out[k] = (_accumulator[2*k] + _accumulator[2*k+1])*scale;
+        }
+        if (_outputMode == FFT_OUTPUT_DB) for (size_t k = 0; k < _numBins; k++)
+        {
+            out[k] = Type(10)*std::log10(std::max(out[k], fftPowerFloor<Type>()));
+        }
+        outPort->produce(_numBins);
+
+        this->resetAccumulator();
+        _nextOutput += this->intervalDuration();
+        const auto now = std::chrono::high_resolution_clock::now();
+        if (_nextOutput < now) _nextOutput = now + this->intervalDuration();
+    }
+
+private:
+    std::chrono::high_resolution_clock::duration intervalDuration(void) const
+    {
+        return std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+            std::chrono::duration<double>(_interval));
+    }
+
+    void resetAccumulator(void)
+    {
+        std::fill(_accumulator.begin(), _accumulator.end(), Type(0));
+        _numFrames = 0;
+    }
+
+    void recalculateWindow(void)
+    {
+        const auto window = design_window(_windowType, _numBins, _windowArgs.empty()?0.0:_windowArgs.at(0));
+        if (window.size() != _numBins) throw Pothos::InvalidArgumentException("PSD::setWindowType("+_windowType+")", "unknown window type");
+        _window.assign(window.begin(), window.end());
+        _windowPower = 0.0;
+        for (const auto w : window) _windowPower += w*w;
+        this->resetAccumulator();
+    }
+
+    const size_t _numBins;
+    size_t _hop;
+    size_t _numAverages;
+    double _interval;
+    FFTOutputMode _outputMode;
+    std::string _windowType;
+    std::vector<double> _windowArgs;
+    std::vector<Type> _window;
+    double _windowPower;
+    std::vector<std::complex<Type>> _stage;
+    std::vector<std::complex<Type>> _spectrum;
+
+    //interleaved re^2/im^2 sums, combined per bin only when producing output
+    std::vector<Type> _accumulator;
+    size_t _numFrames;
+    std::chrono::high_resolution_clock::time_point _nextOutput;
+    std::unique_ptr<FFTAux<std::complex<Type>>> _fftAux;
+    static AccumulateSquaresFcn<Type> _accumulateSquares;
+};
+
+template <typename InType, typename Type>
+AccumulateSquaresFcn<Type> PSD<InType, Type>::_accumulateSquares = getAccumulateSquaresFcn<Type>();
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *PSDFactory(const Pothos::DType &dtype, const size_t numBins)
+{
+    if (numBins == 0) throw Pothos::InvalidArgumentException("PSDFactory()", "num bins cannot be 0");
+
+    #define ifTypeDeclareFactory(Type) \
+        if (dtype == Pothos::DType(typeid(Type))) return new PSD<Type, Type>(numBins); \
+        if (dtype == Pothos::DType(typeid(std::complex<Type>))) return new PSD<std::complex<Type>, Type>(numBins);
+    ifTypeDeclareFactory(double);
+    ifTypeDeclareFactory(float);
+    throw Pothos::InvalidArgumentException("PSDFactory("+dtype.toString()+")", "unsupported type");
+}
+static Pothos::BlockRegistry registerPSD(
+    "/comms/psd", &PSDFactory);
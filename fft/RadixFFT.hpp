@@ -0,0 +1,308 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#ifdef POTHOS_XSIMD
+#include "SIMD/FFTBlocks_SIMD.hpp"
+#endif
+
+#include <complex>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <new>
+
+/***********************************************************************
+ * Minimal aligned allocator for twiddle tables and split scratch,
+ * so that the vectorized butterflies can stream aligned memory.
+ **********************************************************************/
+template <typename T, size_t Alignment = 64>
+struct FFTAlignedAllocator
+{
+    typedef T value_type;
+
+    FFTAlignedAllocator(void) {}
+    template <typename U> FFTAlignedAllocator(const FFTAlignedAllocator<U, Alignment> &) {}
+    template <typename U> struct rebind { typedef FFTAlignedAllocator<U, Alignment> other; };
+
+    T *allocate(const size_t n)
+    {
+        void *mem = std::malloc(n*sizeof(T) + Alignment + sizeof(void *));
+        if (mem == nullptr) throw std::bad_alloc();
+        auto addr = (reinterpret_cast<size_t>(mem) + sizeof(void *) + Alignment - 1) & ~(Alignment - 1);
+        reinterpret_cast<void **>(addr)[-1] = mem;
+        return reinterpret_cast<T *>(addr);
+    }
+
+    void deallocate(T *p, const size_t)
+    {
+        if (p != nullptr) std::free(reinterpret_cast<void **>(p)[-1]);
+    }
+};
+
+template <typename T, typename U, size_t A>
+bool operator==(const FFTAlignedAllocator<T, A> &, const FFTAlignedAllocator<U, A> &) { return true; }
+
+template <typename T, typename U, size_t A>
+bool operator!=(const FFTAlignedAllocator<T, A> &, const FFTAlignedAllocator<U, A> &) { return false; }
+
+template <typename T>
+using FFTAlignedVector = std::vector<T, FFTAlignedAllocator<T>>;
+
+/***********************************************************************
+ * Butterfly stage implementations operating on split real/imag arrays.
+ * The radix-2^2 stage fuses two consecutive radix-2 stages
+ * (spans 2h and 4h) so that each stage pair is one pass over memory.
+ * Twiddle layout: radix-2 [wr(h) | wi(h)],
+ * radix-2^2 [w1r(h) | w1i(h) | w2r(h) | w2i(h)].
+ **********************************************************************/
+template <typename T>
+using FFTStageFcn = void(*)(T*, T*, const T*, const size_t, const size_t);
+
+template <typename T>
+static void fftRadix2StageScalar(T *re, T *im, const T *tw, const size_t N, const size_t h)
+{
+    const T *twr = tw, *twi = tw + h;
+    for (size_t b = 0; b < N; b += 2*h)
+    {
+        T *ar = re+b, *ai = im+b, *br = re+b+h, *bi = im+b+h;
+        for (size_t k = 0; k < h; k++)
+        {
+            const T tr = br[k]*twr[k] - bi[k]*twi[k];
+            const T ti = br[k]*twi[k] + bi[k]*twr[k];
+            br[k] = ar[k] - tr;
+            bi[k] = ai[k] - ti;
+            ar[k] += tr;
+            ai[k] += ti;
+        }
+    }
+}
+
+template <typename T>
+static void fftRadix22StageScalar(T *re, T *im, const T *tw, const size_t N, const size_t h)
+{
+    const T *w1r = tw, *w1i = tw + h, *w2r = tw + 2*h, *w2i = tw + 3*h;
+    for (size_t b = 0; b < N; b += 4*h)
+    {
+        T *r0 = re+b, *r1 = r0+h, *r2 = r1+h, *r3 = r2+h;
+        T *i0 = im+b, *i1 = i0+h, *i2 = i1+h, *i3 = i2+h;
+        for (size_t k = 0; k < h; k++)
+        {
+            //first radix-2 stage over span 2h
+            const T t1r = r1[k]*w1r[k] - i1[k]*w1i[k];
+            const T t1i = r1[k]*w1i[k] + i1[k]*w1r[k];
+            const T t2r = r3[k]*w1r[k] - i3[k]*w1i[k];
+            const T t2i = r3[k]*w1i[k] + i3[k]*w1r[k];
+            const T a1r = r0[k] + t1r, a1i = i0[k] + t1i;
+            const T b1r = r0[k] - t1r, b1i = i0[k] - t1i;
+            const T c1r = r2[k] + t2r, c1i = i2[k] + t2i;
+            const T d1r = r2[k] - t2r, d1i = i2[k] - t2i;
+
+            //second radix-2 stage over span 4h, W^(k+h) = -j*W^k
+            const T t3r = c1r*w2r[k] - c1i*w2i[k];
+            const T t3i = c1r*w2i[k] + c1i*w2r[k];
+            const T t4r = d1i*w2r[k] + d1r*w2i[k];
+            const T t4i = d1i*w2i[k] - d1r*w2r[k];
+            r0[k] = a1r + t3r; i0[k] = a1i + t3i;
+            r2[k] = a1r - t3r; i2[k] = a1i - t3i;
+            r1[k] = b1r + t4r; i1[k] = b1i + t4i;
+            r3[k] = b1r - t4r; i3[k] = b1i - t4i;
+        }
+    }
+}
+
+#ifdef POTHOS_XSIMD
+
+template <typename T>
+static inline FFTStageFcn<T> getRadix2StageFcn(void)
+{
+    return PothosCommsSIMD::fftRadix2StageDispatch<T>();
+}
+
+template <typename T>
+static inline FFTStageFcn<T> getRadix22StageFcn(void)
+{
+    return PothosCommsSIMD::fftRadix22StageDispatch<T>();
+}
+
+#else
+
+template <typename T>
+static inline FFTStageFcn<T> getRadix2StageFcn(void)
+{
+    return &fftRadix2StageScalar<T>;
+}
+
+template <typename T>
+static inline FFTStageFcn<T> getRadix22StageFcn(void)
+{
+    return &fftRadix22StageScalar<T>;
+}
+
+#endif
+
+/***********************************************************************
+ * Power-of-two decimation-in-time FFT engine:
+ * Input is bit-reverse permuted into split real/imag scratch,
+ * the butterfly stages run in place with precomputed twiddles,
+ * and the result is interleaved back into the output.
+ * The inverse transform is performed by swapping the real and
+ * imaginary arrays, and like kissfft, the inverse is not scaled.
+ * The engine is immutable after construction so that it can be
+ * shared between users; each caller provides its own scratch.
+ *
+ * A batched engine transforms batch channel-interleaved inputs at once:
+ * the scratch holds the batch values of each point contiguously,
+ * which is a single transform of nfft*batch points with every span
+ * and twiddle scaled by batch, so the same butterfly kernels run
+ * full-width vector loops across channels even in the short early stages.
+ **********************************************************************/
+template <typename Type>
+class RadixFFT
+{
+public:
+    RadixFFT(const size_t nfft, const bool inverse, const size_t batch = 1):
+        _nfft(nfft),
+        _inverse(inverse),
+        _batch(batch),
+        _bitrev(nfft),
+        _radix2Stage(getRadix2StageFcn<Type>()),
+        _radix22Stage(getRadix22StageFcn<Type>())
+    {
+        //bit reversal permutation table
+        size_t numBits = 0;
+        while ((size_t(1) << numBits) < nfft) numBits++;
+        for (size_t n = 0; n < nfft; n++)
+        {
+            size_t r = 0;
+            for (size_t b = 0; b < numBits; b++) r |= ((n >> b) & 0x1) << (numBits-1-b);
+            _bitrev[n] = uint32_t(r);
+        }
+
+        //an odd number of radix-2 stages begins with a single radix-2 stage
+        size_t h = 1;
+        if ((numBits % 2) != 0)
+        {
+            this->addStage(2, h);
+            h *= 2;
+        }
+        for (; h < nfft; h *= 4) this->addStage(4, h);
+    }
+
+    //! True when the engine can perform a transform of this size
+    static bool supportsSize(const size_t nfft)
+    {
+        return nfft >= 2 and nfft <= (size_t(1) << 31) and (nfft & (nfft-1)) == 0;
+    }
+
+    //! The number of scratch elements that the caller must provide
+    size_t scratchSize(void) const
+    {
+        return 2*_nfft*_batch;
+    }
+
+    /*!
+     * Transform src and pass the result as split real/imag arrays to store(re, im),
+     * so that output conversions can be fused with the final stores.
+     * Batched engines interleave the channels of src and of the result.
+     */
+    template <typename StoreFcn>
+    void transform(const std::complex<Type> *src, Type *scratch, const StoreFcn &store) const
+    {
+        //the inverse is the forward transform with real and imaginary swapped
+        const size_t total = _nfft*_batch;
+        Type *re = scratch, *im = scratch + total;
+        Type *ioRe = _inverse?im:re;
+        Type *ioIm = _inverse?re:im;
+
+        if (_batch == 1) for (size_t n = 0; n < _nfft; n++)
+        {
+            const auto r = _bitrev[n];
+            ioRe[r] = src[n].real();
+            ioIm[r] = src[n].imag();
+        }
+        else for (size_t n = 0; n < _nfft; n++)
+        {
+            const auto s = src + n*_batch;
+            const size_t r = _bitrev[n]*_batch;
+            for (size_t c = 0; c < _batch; c++)
+            {
+                ioRe[r+c] = s[c].real();
+                ioIm[r+c] = s[c].imag();
+            }
+        }
+
+        for (const auto &stage : _stages)
+        {
+            const Type *tw = _twiddles.data() + stage.twiddleOffset;
+            if (stage.radix == 2) _radix2Stage(re, im, tw, total, stage.span*_batch);
+            else _radix22Stage(re, im, tw, total, stage.span*_batch);
+        }
+
+        store(static_cast<const Type *>(ioRe), static_cast<const Type *>(ioIm));
+    }
+
+    //! Transform src into dst, where bin k is stored at (k + offset) % nfft
+    void transform(const std::complex<Type> *src, std::complex<Type> *dst, Type *scratch, const size_t offset = 0) const
+    {
+        const size_t total = _nfft*_batch;
+        const size_t shift = offset*_batch;
+        const size_t split = total - shift;
+        this->transform(src, scratch, [&](const Type *re, const Type *im)
+        {
+            for (size_t n = 0; n < split; n++) dst[n+shift] = std::complex<Type>(re[n], im[n]);
+            for (size_t n = split; n < total; n++) dst[n-split] = std::complex<Type>(re[n], im[n]);
+        });
+    }
+
+private:
+    void addStage(const size_t radix, const size_t h)
+    {
+        Stage stage;
+        stage.radix = radix;
+        stage.span = h;
+        stage.twiddleOffset = _twiddles.size();
+        _stages.push_back(stage);
+
+        //twiddles are computed in double precision, always forward
+        const double pi = std::acos(-1.0);
+        std::vector<std::complex<double>> w1(h), w2(h);
+        for (size_t k = 0; k < h; k++)
+        {
+            w1[k] = std::polar(1.0, -pi*k/h);
+            w2[k] = std::polar(1.0, -pi*k/(2*h));
+        }
+        //batched engines repeat every twiddle once per channel
+        const auto append = [&](const std::vector<std::complex<double>> &w, const bool imag)
+        {
+            for (size_t k = 0; k < h; k++)
+            {
+                const Type t(imag?w[k].imag():w[k].real());
+                _twiddles.insert(_twiddles.end(), _batch, t);
+            }
+        };
+        append(w1, false);
+        append(w1, true);
+        if (radix == 2) return;
+        append(w2, false);
+        append(w2, true);
+    }
+
+    struct Stage
+    {
+        size_t radix;
+        size_t span;
+        size_t twiddleOffset;
+    };
+
+    const size_t _nfft;
+    const bool _inverse;
+    const size_t _batch;
+    std::vector<uint32_t> _bitrev;
+    std::vector<Stage> _stages;
+    FFTAlignedVector<Type> _twiddles;
+    FFTStageFcn<Type> _radix2Stage;
+    FFTStageFcn<Type> _radix22Stage;
+};
@@ -0,0 +1,70 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <xsimd/xsimd.hpp>
+#include <Pothos/Util/XSIMDTraits.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+// Actually enforce EnableIfXSIMDSupports
+#ifdef _MSC_VER
+#pragma warning(error: 4667) // no function template defined that matches forced instantiation
+#endif
+
+#if !defined POTHOS_SIMD_NAMESPACE
+#error Must define POTHOS_SIMD_NAMESPACE to build this file
+#endif
+
+namespace PothosCommsSIMD { namespace POTHOS_SIMD_NAMESPACE {
+
+namespace detail
+{
+    /*******************************************************************
+     * acc[i] += in[i]*in[i], used on interleaved complex bins so that
+     * the real and imaginary squares accumulate without shuffles
+     ******************************************************************/
+    template <typename T>
+    static void fftAccumulateSquaresUnoptimized(const T *in, T *acc, const size_t num)
+    {
+        for (size_t i = 0; i < num; i++) acc[i] += in[i]*in[i];
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDSupports<T, void> fftAccumulateSquares(const T *in, T *acc, const size_t num)
+    {
+        static constexpr size_t simdSize = xsimd::simd_traits<T>::size;
+        const size_t numSIMDFrames = num / simdSize;
+
+        for (size_t i = 0; i < numSIMDFrames*simdSize; i += simdSize)
+        {
+            const auto x = xsimd::load_unaligned(in+i);
+            const auto a = xsimd::load_unaligned(acc+i);
+            (a + x*x).store_unaligned(acc+i);
+        }
+
+        const size_t tail = numSIMDFrames*simdSize;
+        fftAccumulateSquaresUnoptimized(in+tail, acc+tail, num-tail);
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDDoesNotSupport<T, void> fftAccumulateSquares(const T *in, T *acc, const size_t num)
+    {
+        fftAccumulateSquaresUnoptimized(in, acc, num);
+    }
+}
+
+// Hide the SFINAE
+template <typename T>
+void fftAccumulateSquares(const T *in, T *acc, const size_t num)
+{
+    detail::fftAccumulateSquares(in, acc, num);
+}
+
+#define FFT_ACCUMULATE(T) \
+    template void fftAccumulateSquares(const T*, T*, size_t);
+
+    FFT_ACCUMULATE(float)
+    FFT_ACCUMULATE(double)
+
+}}
@@ -0,0 +1,176 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <xsimd/xsimd.hpp>
+#include <Pothos/Util/XSIMDTraits.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <type_traits>
+
+// Actually enforce EnableIfXSIMDSupports
+#ifdef _MSC_VER
+#pragma warning(error: 4667) // no function template defined that matches forced instantiation
+#endif
+
+#if !defined POTHOS_SIMD_NAMESPACE
+#error Must define POTHOS_SIMD_NAMESPACE to build this file
+#endif
+
+namespace PothosCommsSIMD { namespace POTHOS_SIMD_NAMESPACE {
+
+namespace detail
+{
+    /*******************************************************************
+     * Block-floating-point radix-2 stage over split int16 arrays:
+     * Q15 twiddles, 32-bit products rounded back to int16,
+     * the stage output shifted down by shift bits,
+     * and the largest output component magnitude stored in maxAbs
+     ******************************************************************/
+    template <typename T>
+    static void fftBlockFloatButterflies(T *ar, T *ai, T *br, T *bi, const T *twr, const T *twi, const size_t k0, const size_t h, const int shift, int32_t &maxAbs)
+    {
+        const int32_t rnd = (shift == 0)?0:(1 << (shift-1));
+        for (size_t k = k0; k < h; k++)
+        {
+            const int32_t tr = (int32_t(br[k])*twr[k] - int32_t(bi[k])*twi[k] + (1 << 14)) >> 15;
+            const int32_t ti = (int32_t(br[k])*twi[k] + int32_t(bi[k])*twr[k] + (1 << 14)) >> 15;
+            const int32_t xr = (int32_t(ar[k]) + tr + rnd) >> shift;
+            const int32_t xi = (int32_t(ai[k]) + ti + rnd) >> shift;
+            const int32_t yr = (int32_t(ar[k]) - tr + rnd) >> shift;
+            const int32_t yi = (int32_t(ai[k]) - ti + rnd) >> shift;
+            ar[k] = T(xr); ai[k] = T(xi);
+            br[k] = T(yr); bi[k] = T(yi);
+            maxAbs = std::max(maxAbs, std::max(std::max(std::abs(xr), std::abs(xi)), std::max(std::abs(yr), std::abs(yi))));
+        }
+    }
+
+    template <typename T>
+    static void fftBlockFloatStageUnoptimized(T *re, T *im, const T *twr, const T *twi, const size_t N, const size_t h, const int shift, int *maxAbs)
+    {
+        int32_t m = 0;
+        for (size_t b = 0; b < N; b += 2*h)
+        {
+            fftBlockFloatButterflies(re+b, im+b, re+b+h, im+b+h, twr, twi, 0, h, shift, m);
+        }
+        *maxAbs = int(m);
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDSupports<T, void> fftBlockFloatStage(T *re, T *im, const T *twr, const T *twi, const size_t N, const size_t h, const int shift, int *maxAbs)
+    {
+        //the int16 values are widened to 32-bit lanes for the Q15 products
+        static constexpr size_t simdSize = xsimd::simd_traits<int32_t>::size;
+        using Batch = xsimd::batch<int32_t, simdSize>;
+
+        //spans shorter than a register are handled by the scalar loop
+        if (h < simdSize) return fftBlockFloatStageUnoptimized(re, im, twr, twi, N, h, shift, maxAbs);
+
+        const size_t hVec = h - (h % simdSize);
+        const Batch q15Rnd(int32_t(1 << 14));
+        const Batch rnd(int32_t((shift == 0)?0:(1 << (shift-1))));
+        Batch maxVec(int32_t(0));
+        int32_t m = 0;
+        for (size_t b = 0; b < N; b += 2*h)
+        {
+            T *ar = re+b, *ai = im+b, *br = re+b+h, *bi = im+b+h;
+            for (size_t k = 0; k < hVec; k += simdSize)
+            {
+                Batch wr, wi, xar, xai, xbr, xbi;
+                wr.load_unaligned(twr+k);
+                wi.load_unaligned(twi+k);
+                xar.load_unaligned(ar+k);
+                xai.load_unaligned(ai+k);
+                xbr.load_unaligned(br+k);
+                xbi.load_unaligned(bi+k);
+
+                const auto tr = (xbr*wr - xbi*wi + q15Rnd) >> 15;
+                const auto ti = (xbr*wi + xbi*wr + q15Rnd) >> 15;
+                const auto xr = (xar + tr + rnd) >> shift;
+                const auto xi = (xai + ti + rnd) >> shift;
+                const auto yr = (xar - tr + rnd) >> shift;
+                const auto yi = (xai - ti + rnd) >> shift;
+                xr.store_unaligned(ar+k);
+                xi.store_unaligned(ai+k);
+                yr.store_unaligned(br+k);
+                yi.store_unaligned(bi+k);
+                maxVec = xsimd::max(maxVec, xsimd::max(xsimd::max(xsimd::abs(xr), xsimd::abs(xi)), xsimd::max(xsimd::abs(yr), xsimd::abs(yi))));
+            }
+            fftBlockFloatButterflies(ar, ai, br, bi, twr, twi, hVec, h, shift, m);
+        }
+
+        int32_t lanes[simdSize];
+        maxVec.store_unaligned(lanes);
+        for (size_t k = 0; k < simdSize; k++) m = std::max(m, lanes[k]);
+        *maxAbs = int(m);
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDDoesNotSupport<T, void> fftBlockFloatStage(T *re, T *im, const T *twr, const T *twi, const size_t N, const size_t h, const int shift, int *maxAbs)
+    {
+        fftBlockFloatStageUnoptimized(re, im, twr, twi, N, h, shift, maxAbs);
+    }
+
+    /*******************************************************************
+     * Largest component magnitude of an int16 array
+     ******************************************************************/
+    template <typename T>
+    static void fftBlockFloatMaxAbsUnoptimized(const T *in, const size_t num, int *maxAbs)
+    {
+        int32_t m = 0;
+        for (size_t i = 0; i < num; i++) m = std::max(m, std::abs(int32_t(in[i])));
+        *maxAbs = int(m);
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDSupports<T, void> fftBlockFloatMaxAbs(const T *in, const size_t num, int *maxAbs)
+    {
+        static constexpr size_t simdSize = xsimd::simd_traits<int32_t>::size;
+        using Batch = xsimd::batch<int32_t, simdSize>;
+        const size_t numSIMDFrames = num / simdSize;
+
+        Batch maxVec(int32_t(0));
+        for (size_t i = 0; i < numSIMDFrames*simdSize; i += simdSize)
+        {
+            Batch x;
+            x.load_unaligned(in+i);
+            maxVec = xsimd::max(maxVec, xsimd::abs(x));
+        }
+
+        const size_t tail = numSIMDFrames*simdSize;
+        fftBlockFloatMaxAbsUnoptimized(in+tail, num-tail, maxAbs);
+
+        int32_t lanes[simdSize];
+        maxVec.store_unaligned(lanes);
+        for (size_t k = 0; k < simdSize; k++) *maxAbs = std::max(*maxAbs, int(lanes[k]));
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDDoesNotSupport<T, void> fftBlockFloatMaxAbs(const T *in, const size_t num, int *maxAbs)
+    {
+        fftBlockFloatMaxAbsUnoptimized(in, num, maxAbs);
+    }
+}
+
+// Hide the SFINAE
+template <typename T>
+void fftBlockFloatStage(T *re, T *im, const T *twr, const T *twi, const size_t N, const size_t h, const int shift, int *maxAbs)
+{
+    detail::fftBlockFloatStage(re, im, twr, twi, N, h, shift, maxAbs);
+}
+
+template <typename T>
+void fftBlockFloatMaxAbs(const T *in, const size_t num, int *maxAbs)
+{
+    detail::fftBlockFloatMaxAbs(in, num, maxAbs);
+}
+
+#define FFT_BLOCK_FLOAT(T) \
+    template void fftBlockFloatStage(T*, T*, const T*, const T*, size_t, size_t, int, int*); \
+    template void fftBlockFloatMaxAbs(const T*, size_t, int*);
+
+    FFT_BLOCK_FLOAT(std::int16_t)
+
+}}
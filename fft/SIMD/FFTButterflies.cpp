@@ -0,0 +1,215 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <xsimd/xsimd.hpp>
+#include <Pothos/Util/XSIMDTraits.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+// Actually enforce EnableIfXSIMDSupports
+#ifdef _MSC_VER
+#pragma warning(error: 4667) // no function template defined that matches forced instantiation
+#endif
+
+#if !defined POTHOS_SIMD_NAMESPACE
+#error Must define POTHOS_SIMD_NAMESPACE to build this file
+#endif
+
+namespace PothosCommsSIMD { namespace POTHOS_SIMD_NAMESPACE {
+
+namespace detail
+{
+    /*******************************************************************
+     * Radix-2 stage over split real/imag arrays, twiddles [wr | wi]
+     ******************************************************************/
+    template <typename T>
+    static void fftRadix2Butterflies(T *ar, T *ai, T *br, T *bi, const T *twr, const T *twi, const size_t k0, const size_t h)
+    {
+        for (size_t k = k0; k < h; k++)
+        {
+            const T tr = br[k]*twr[k] - bi[k]*twi[k];
+            const T ti = br[k]*twi[k] + bi[k]*twr[k];
+            br[k] = ar[k] - tr;
+            bi[k] = ai[k] - ti;
+            ar[k] += tr;
+            ai[k] += ti;
+        }
+    }
+
+    template <typename T>
+    static void fftRadix2StageUnoptimized(T *re, T *im, const T *tw, const size_t N, const size_t h)
+    {
+        for (size_t b = 0; b < N; b += 2*h)
+        {
+            fftRadix2Butterflies(re+b, im+b, re+b+h, im+b+h, tw, tw+h, 0, h);
+        }
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDSupports<T, void> fftRadix2Stage(T *re, T *im, const T *tw, const size_t N, const size_t h)
+    {
+        static constexpr size_t simdSize = xsimd::simd_traits<T>::size;
+
+        //spans shorter than a register are handled by the scalar loop
+        if (h < simdSize) return fftRadix2StageUnoptimized(re, im, tw, N, h);
+
+        //spans that are not a multiple of the register (batched transforms) end with a scalar tail
+        const size_t hVec = h - (h % simdSize);
+        const T *twr = tw, *twi = tw + h;
+        for (size_t b = 0; b < N; b += 2*h)
+        {
+            T *ar = re+b, *ai = im+b, *br = re+b+h, *bi = im+b+h;
+            for (size_t k = 0; k < hVec; k += simdSize)
+            {
+                const auto wr = xsimd::load_unaligned(twr+k);
+                const auto wi = xsimd::load_unaligned(twi+k);
+                const auto xbr = xsimd::load_unaligned(br+k);
+                const auto xbi = xsimd::load_unaligned(bi+k);
+                const auto xar = xsimd::load_unaligned(ar+k);
+                const auto xai = xsimd::load_unaligned(ai+k);
+
+                const auto tr = xbr*wr - xbi*wi;
+                const auto ti = xbr*wi + xbi*wr;
+                (xar - tr).store_unaligned(br+k);
+                (xai - ti).store_unaligned(bi+k);
+                (xar + tr).store_unaligned(ar+k);
+                (xai + ti).store_unaligned(ai+k);
+            }
+            fftRadix2Butterflies(ar, ai, br, bi, twr, twi, hVec, h);
+        }
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDDoesNotSupport<T, void> fftRadix2Stage(T *re, T *im, const T *tw, const size_t N, const size_t h)
+    {
+        fftRadix2StageUnoptimized(re, im, tw, N, h);
+    }
+
+    /*******************************************************************
+     * Fused radix-2^2 stage (spans 2h and 4h),
+     * twiddles [w1r | w1i | w2r | w2i]
+     ******************************************************************/
+    template <typename T>
+    static void fftRadix22Butterflies(T *re, T *im, const T *tw, const size_t k0, const size_t h)
+    {
+        const T *w1r = tw, *w1i = tw + h, *w2r = tw + 2*h, *w2i = tw + 3*h;
+        T *r0 = re, *r1 = r0+h, *r2 = r1+h, *r3 = r2+h;
+        T *i0 = im, *i1 = i0+h, *i2 = i1+h, *i3 = i2+h;
+        for (size_t k = k0; k < h; k++)
+        {
+            const T t1r = r1[k]*w1r[k] - i1[k]*w1i[k];
+            const T t1i = r1[k]*w1i[k] + i1[k]*w1r[k];
+            const T t2r = r3[k]*w1r[k] - i3[k]*w1i[k];
+            const T t2i = r3[k]*w1i[k] + i3[k]*w1r[k];
+            const T a1r = r0[k] + t1r, a1i = i0[k] + t1i;
+            const T b1r = r0[k] - t1r, b1i = i0[k] - t1i;
+            const T c1r = r2[k] + t2r, c1i = i2[k] + t2i;
+            const T d1r = r2[k] - t2r, d1i = i2[k] - t2i;
+
+            const T t3r = c1r*w2r[k] - c1i*w2i[k];
+            const T t3i = c1r*w2i[k] + c1i*w2r[k];
+            const T t4r = d1i*w2r[k] + d1r*w2i[k];
+            const T t4i = d1i*w2i[k] - d1r*w2r[k];
+            r0[k] = a1r + t3r; i0[k] = a1i + t3i;
+            r2[k] = a1r - t3r; i2[k] = a1i - t3i;
+            r1[k] = b1r + t4r; i1[k] = b1i + t4i;
+            r3[k] = b1r - t4r; i3[k] = b1i - t4i;
+        }
+    }
+
+    template <typename T>
+    static void fftRadix22StageUnoptimized(T *re, T *im, const T *tw, const size_t N, const size_t h)
+    {
+        for (size_t b = 0; b < N; b += 4*h)
+        {
+            fftRadix22Butterflies(re+b, im+b, tw, 0, h);
+        }
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDSupports<T, void> fftRadix22Stage(T *re, T *im, const T *tw, const size_t N, const size_t h)
+    {
+        static constexpr size_t simdSize = xsimd::simd_traits<T>::size;
+
+        //spans shorter than a register are handled by the scalar loop
+        if (h < simdSize) return fftRadix22StageUnoptimized(re, im, tw, N, h);
+
+        //spans that are not a multiple of the register (batched transforms) end with a scalar tail
+        const size_t hVec = h - (h % simdSize);
+        const T *w1r = tw, *w1i = tw + h, *w2r = tw + 2*h, *w2i = tw + 3*h;
+        for (size_t b = 0; b < N; b += 4*h)
+        {
+            T *r0 = re+b, *r1 = r0+h, *r2 = r1+h, *r3 = r2+h;
+            T *i0 = im+b, *i1 = i0+h, *i2 = i1+h, *i3 = i2+h;
+            for (size_t k = 0; k < hVec; k += simdSize)
+            {
+                const auto xw1r = xsimd::load_unaligned(w1r+k);
+                const auto xw1i = xsimd::load_unaligned(w1i+k);
+                const auto xw2r = xsimd::load_unaligned(w2r+k);
+                const auto xw2i = xsimd::load_unaligned(w2i+k);
+                const auto x0r = xsimd::load_unaligned(r0+k);
+                const auto x0i = xsimd::load_unaligned(i0+k);
+                const auto x1r = xsimd::load_unaligned(r1+k);
+                const auto x1i = xsimd::load_unaligned(i1+k);
+                const auto x2r = xsimd::load_unaligned(r2+k);
+                const auto x2i = xsimd::load_unaligned(i2+k);
+                const auto x3r = xsimd::load_unaligned(r3+k);
+                const auto x3i = xsimd::load_unaligned(i3+k);
+
+                //first radix-2 stage over span 2h
+                const auto t1r = x1r*xw1r - x1i*xw1i;
+                const auto t1i = x1r*xw1i + x1i*xw1r;
+                const auto t2r = x3r*xw1r - x3i*xw1i;
+                const auto t2i = x3r*xw1i + x3i*xw1r;
+                const auto a1r = x0r + t1r, a1i = x0i + t1i;
+                const auto b1r = x0r - t1r, b1i = x0i - t1i;
+                const auto c1r = x2r + t2r, c1i = x2i + t2i;
+                const auto d1r = x2r - t2r, d1i = x2i - t2i;
+
+                //second radix-2 stage over span 4h, W^(k+h) = -j*W^k
+                const auto t3r = c1r*xw2r - c1i*xw2i;
+                const auto t3i = c1r*xw2i + c1i*xw2r;
+                const auto t4r = d1i*xw2r + d1r*xw2i;
+                const auto t4i = d1i*xw2i - d1r*xw2r;
+                (a1r + t3r).store_unaligned(r0+k);
+                (a1i + t3i).store_unaligned(i0+k);
+                (a1r - t3r).store_unaligned(r2+k);
+                (a1i - t3i).store_unaligned(i2+k);
+                (b1r + t4r).store_unaligned(r1+k);
+                (b1i + t4i).store_unaligned(i1+k);
+                (b1r - t4r).store_unaligned(r3+k);
+                (b1i - t4i).store_unaligned(i3+k);
+            }
+            fftRadix22Butterflies(re+b, im+b, tw, hVec, h);
+        }
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDDoesNotSupport<T, void> fftRadix22Stage(T *re, T *im, const T *tw, const size_t N, const size_t h)
+    {
+        fftRadix22StageUnoptimized(re, im, tw, N, h);
+    }
+}
+
+// Hide the SFINAE
+template <typename T>
+void fftRadix2Stage(T *re, T *im, const T *tw, const size_t N, const size_t h)
+{
+    detail::fftRadix2Stage(re, im, tw, N, h);
+}
+
+template <typename T>
+void fftRadix22Stage(T *re, T *im, const T *tw, const size_t N, const size_t h)
+{
+    detail::fftRadix22Stage(re, im, tw, N, h);
+}
+
+#define FFT_STAGES(T) \
+    template void fftRadix2Stage(T*, T*, const T*, size_t, size_t); \
+    template void fftRadix22Stage(T*, T*, const T*, size_t, size_t);
+
+    FFT_STAGES(float)
+    FFT_STAGES(double)
+
+}}
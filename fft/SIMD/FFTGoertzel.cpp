@@ -0,0 +1,166 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <xsimd/xsimd.hpp>
+#include <Pothos/Util/XSIMDTraits.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+// Actually enforce EnableIfXSIMDSupports
+#ifdef _MSC_VER
+#pragma warning(error: 4667) // no function template defined that matches forced instantiation
+#endif
+
+#if !defined POTHOS_SIMD_NAMESPACE
+#error Must define POTHOS_SIMD_NAMESPACE to build this file
+#endif
+
+namespace PothosCommsSIMD { namespace POTHOS_SIMD_NAMESPACE {
+
+namespace detail
+{
+    /*******************************************************************
+     * Goertzel recursion s[n] = x[n] + c*s[n-1] - s[n-2] for a bank of bins,
+     * input interleaved complex, coefficients c = 2*cos(w) per bin,
+     * state [s1re | s1im | s2re | s2im] with a stride of numBins
+     ******************************************************************/
+    template <typename T>
+    static void goertzelBankUpdateUnoptimized(const T *in, const size_t numSamples, const T *coeff, T *state, const size_t begin, const size_t numBins)
+    {
+        T *s1r = state, *s1i = state+numBins, *s2r = state+2*numBins, *s2i = state+3*numBins;
+        for (size_t k = begin; k < numBins; k++)
+        {
+            T ar = s1r[k], ai = s1i[k], br = s2r[k], bi = s2i[k];
+            for (size_t n = 0; n < numSamples; n++)
+            {
+                const T r = in[2*n+0] + coeff[k]*ar - br;
+                const T i = in[2*n+1] + coeff[k]*ai - bi;
+                br = ar; bi = ai;
+                ar = r; ai = i;
+            }
+            s1r[k] = ar; s1i[k] = ai; s2r[k] = br; s2i[k] = bi;
+        }
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDSupports<T, void> goertzelBankUpdate(const T *in, const size_t numSamples, const T *coeff, T *state, const size_t numBins)
+    {
+        static constexpr size_t simdSize = xsimd::simd_traits<T>::size;
+        const size_t numSIMDFrames = numBins / simdSize;
+        T *s1r = state, *s1i = state+numBins, *s2r = state+2*numBins, *s2i = state+3*numBins;
+
+        //the bins of one register stay in registers for the whole input
+        for (size_t k = 0; k < numSIMDFrames*simdSize; k += simdSize)
+        {
+            const auto c = xsimd::load_unaligned(coeff+k);
+            auto ar = xsimd::load_unaligned(s1r+k);
+            auto ai = xsimd::load_unaligned(s1i+k);
+            auto br = xsimd::load_unaligned(s2r+k);
+            auto bi = xsimd::load_unaligned(s2i+k);
+            for (size_t n = 0; n < numSamples; n++)
+            {
+                const auto r = xsimd::batch<T, simdSize>(in[2*n+0]) + c*ar - br;
+                const auto i = xsimd::batch<T, simdSize>(in[2*n+1]) + c*ai - bi;
+                br = ar; bi = ai;
+                ar = r; ai = i;
+            }
+            ar.store_unaligned(s1r+k);
+            ai.store_unaligned(s1i+k);
+            br.store_unaligned(s2r+k);
+            bi.store_unaligned(s2i+k);
+        }
+
+        goertzelBankUpdateUnoptimized(in, numSamples, coeff, state, numSIMDFrames*simdSize, numBins);
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDDoesNotSupport<T, void> goertzelBankUpdate(const T *in, const size_t numSamples, const T *coeff, T *state, const size_t numBins)
+    {
+        goertzelBankUpdateUnoptimized(in, numSamples, coeff, state, 0, numBins);
+    }
+
+    /*******************************************************************
+     * Sliding DFT S = rot*(S - old[n]) + in[n]*tin for a bank of bins,
+     * inputs interleaved complex, twiddles [rotre | rotim | tinre | tinim]
+     * and state [Sre | Sim] with a stride of numBins
+     ******************************************************************/
+    template <typename T>
+    static void slidingDFTUpdateUnoptimized(const T *in, const T *old, const size_t numSamples, const T *tw, T *state, const size_t begin, const size_t numBins)
+    {
+        const T *rr = tw, *ri = tw+numBins, *tr = tw+2*numBins, *ti = tw+3*numBins;
+        T *sr = state, *si = state+numBins;
+        for (size_t k = begin; k < numBins; k++)
+        {
+            T ar = sr[k], ai = si[k];
+            for (size_t n = 0; n < numSamples; n++)
+            {
+                const T dr = ar - old[2*n+0], di = ai - old[2*n+1];
+                const T xr = in[2*n+0], xi = in[2*n+1];
+                ar = rr[k]*dr - ri[k]*di + xr*tr[k] - xi*ti[k];
+                ai = rr[k]*di + ri[k]*dr + xr*ti[k] + xi*tr[k];
+            }
+            sr[k] = ar; si[k] = ai;
+        }
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDSupports<T, void> slidingDFTUpdate(const T *in, const T *old, const size_t numSamples, const T *tw, T *state, const size_t numBins)
+    {
+        static constexpr size_t simdSize = xsimd::simd_traits<T>::size;
+        const size_t numSIMDFrames = numBins / simdSize;
+        const T *rr = tw, *ri = tw+numBins, *tr = tw+2*numBins, *ti = tw+3*numBins;
+        T *sr = state, *si = state+numBins;
+
+        for (size_t k = 0; k < numSIMDFrames*simdSize; k += simdSize)
+        {
+            const auto wrr = xsimd::load_unaligned(rr+k);
+            const auto wri = xsimd::load_unaligned(ri+k);
+            const auto wtr = xsimd::load_unaligned(tr+k);
+            const auto wti = xsimd::load_unaligned(ti+k);
+            auto ar = xsimd::load_unaligned(sr+k);
+            auto ai = xsimd::load_unaligned(si+k);
+            for (size_t n = 0; n < numSamples; n++)
+            {
+                const auto dr = ar - xsimd::batch<T, simdSize>(old[2*n+0]);
+                const auto di = ai - xsimd::batch<T, simdSize>(old[2*n+1]);
+                const auto xr = xsimd::batch<T, simdSize>(in[2*n+0]);
+                const auto xi = xsimd::batch<T, simdSize>(in[2*n+1]);
+                ar = wrr*dr - wri*di + xr*wtr - xi*wti;
+                ai = wrr*di + wri*dr + xr*wti + xi*wtr;
+            }
+            ar.store_unaligned(sr+k);
+            ai.store_unaligned(si+k);
+        }
+
+        slidingDFTUpdateUnoptimized(in, old, numSamples, tw, state, numSIMDFrames*simdSize, numBins);
+    }
+
+    template <typename T>
+    static Pothos::Util::EnableIfXSIMDDoesNotSupport<T, void> slidingDFTUpdate(const T *in, const T *old, const size_t numSamples, const T *tw, T *state, const size_t numBins)
+    {
+        slidingDFTUpdateUnoptimized(in, old, numSamples, tw, state, 0, numBins);
+    }
+}
+
+// Hide the SFINAE
+template <typename T>
+void goertzelBankUpdate(const T *in, const size_t numSamples, const T *coeff, T *state, const size_t numBins)
+{
+    detail::goertzelBankUpdate(in, numSamples, coeff, state, numBins);
+}
+
+template <typename T>
+void slidingDFTUpdate(const T *in, const T *old, const size_t numSamples, const T *tw, T *state, const size_t numBins)
+{
+    detail::slidingDFTUpdate(in, old, numSamples, tw, state, numBins);
+}
+
+#define FFT_GOERTZEL(T) \
+    template void goertzelBankUpdate(const T*, size_t, const T*, T*, size_t); \
+    template void slidingDFTUpdate(const T*, const T*, size_t, const T*, T*, size_t);
+
+    FFT_GOERTZEL(float)
+    FFT_GOERTZEL(double)
+
+}}
@@ -0,0 +1,260 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework.hpp>
+#include <complex>
+#include <vector>
+#include <string>
+#include <memory>
+#include <algorithm> //max
+#include <spuce/filters/design_window.h>
+#include "FFTAux.h"
+#include "FFTOutputMode.hpp"
+
+using spuce::design_window;
+
+//output buffers hold a whole number of transforms of about this many elements
+static const size_t STFT_SLAB_ELEMENTS = 4096;
+
+/***********************************************************************
+ * |PothosDoc STFT
+ *
+ * Perform a short-time Fourier transform on input port 0
+ * and produce one transform of numBins bins on output port 0
+ * for every hop of input elements.
+ *
+ * Each frame is read straight out of a circular input buffer,
+ * so frames may overlap (hop smaller than numBins) without duplicating
+ * the input stream, or skip input elements (hop larger than numBins).
+ * The window multiply is fused into the staging of the transform input,
+ * and the optional magnitude, power, or log output conversion
+ * is fused into the final stores of the transform.
+ * Every frame that fits in the available input and output
+ * is transformed in the same call to work.
+ *
+ * The window is not normalized, the result matches a window multiply
+ * followed by the forward /comms/fft block.
+ *
+ * |category /FFT
+ * |keywords dft fft stft short time fourier transform spectrogram waterfall window overlap
+ *
+ * |param dtype[Data Type] The data type of the input element stream.
+ * Real inputs are transformed as complex with a zero imaginary part.
+ * |widget DTypeChooser(float=1, cfloat=1)
+ * |default "complex_float32"
+ * |preview disable
+ *
+ * |param numBins[Num FFT Bins] The number of bins per fourier transform.
+ * |default 1024
+ * |option 512
+ * |option 1024
+ * |option 2048
+ * |option 4096
+ * |widget ComboBox(editable=true)
+ *
+ * |param output[Output Mode] The conversion applied to the transform output.
+ * The complex mode produces complex elements of the input precision,
+ * the other modes produce real elements.
+ * |option [Complex] "COMPLEX"
+ * |option [Magnitude] "MAGNITUDE"
+ * |option [Power] "POWER"
+ * |option [Power dB] "DB"
+ * |default "COMPLEX"
+ * |preview disable
+ *
+ * |param hop[Hop Size] The number of input elements between consecutive frames.
+ * |default 256
+ * |widget SpinBox(minimum=1)
+ *
+ * |param window[Window Type] The window function applied to each frame.
+ * |default "hann"
+ * |option [Rectangular] "rectangular"
+ * |option [Hann] "hann"
+ * |option [Hamming] "hamming"
+ * |option [Blackman] "blackman"
+ * |option [Bartlett] "bartlett"
+ * |option [Flat-top] "flattop"
+ * |option [Kaiser] "kaiser"
+ * |option [Chebyshev] "chebyshev"
+ *
+ * |param windowArgs[Window Args] Optional window arguments (depends on window type).
+ * <ul>
+ * <li>When using the <i>Kaiser</i> window, specify [beta] to use the parameterized Kaiser window.</li>
+ * <li>When using the <i>Chebyshev</i> window, specify [atten] to use the Dolph-Chebyshev window with attenuation in dB.</li>
+ * </ul>
+ * |default []
+ * |preview valid
+ *
+ * |param backend[Backend] The FFT implementation used to perform the transform.
+ * See the /comms/fft block for the available backends.
+ * |default "auto"
+ * |option [Automatic] "auto"
+ * |option [KissFFT] "kissfft"
+ * |option [SIMD] "simd"
+ * |option [Four Step] "fourstep"
+ * |preview disable
+ * |tab Advanced
+ *
+ * |factory /comms/stft(dtype, numBins, output)
+ * |setter setHopSize(hop)
+ * |setter setWindowType(window)
+ * |setter setWindowArgs(windowArgs)
+ * |setter setBackend(backend)
+ **********************************************************************/
+template <typename InType, typename Type>
+class STFT : public Pothos::Block
+{
+public:
+    STFT(const size_t numBins, const std::string &output):
+        _numBins(numBins),
+        _outputMode(parseFFTOutputMode(output)),
+        _hop(256),
+        _windowType("hann"),
+        _stage(numBins)
+    {
+        this->setupInput(0, typeid(InType));
+        if (_outputMode == FFT_OUTPUT_COMPLEX) this->setupOutput(0, typeid(std::complex<Type>));
+        else this->setupOutput(0, typeid(Type));
+        this->registerCall(this, POTHOS_FCN_TUPLE(STFT, setHopSize));
+        this->registerCall(this, POTHOS_FCN_TUPLE(STFT, getHopSize));
+        this->registerCall(this, POTHOS_FCN_TUPLE(STFT, setWindowType));
+        this->registerCall(this, POTHOS_FCN_TUPLE(STFT, getWindowType));
+        this->registerCall(this, POTHOS_FCN_TUPLE(STFT, setWindowArgs));
+        this->registerCall(this, POTHOS_FCN_TUPLE(STFT, getWindowArgs));
+        this->registerCall(this, POTHOS_FCN_TUPLE(STFT, setBackend));
+        this->registerCall(this, POTHOS_FCN_TUPLE(STFT, getBackend));
+        this->setHopSize(256); //initial update
+        this->setBackend("auto"); //initial update
+        this->recalculateWindow(); //initial update
+    }
+
+    void setHopSize(const size_t hop)
+    {
+        if (hop == 0) throw Pothos::InvalidArgumentException("STFT::setHopSize()", "hop size cannot be 0");
+        _hop = hop;
+        this->input(0)->setReserve(std::max(_numBins, _hop));
+    }
+
+    size_t getHopSize(void) const
+    {
+        return _hop;
+    }
+
+    void setWindowType(const std::string &type)
+    {
+        _windowType = type;
+        this->recalculateWindow();
+    }
+
+    std::string getWindowType(void) const
+    {
+        return _windowType;
+    }
+
+    void setWindowArgs(const std::vector<double> &args)
+    {
+        _windowArgs = args;
+        this->recalculateWindow();
+    }
+
+    std::vector<double> getWindowArgs(void) const
+    {
+        return _windowArgs;
+    }
+
+    void setBackend(const std::string &backend)
+    {
+        if (not isValidFFTBackend(backend)) throw Pothos::InvalidArgumentException("STFT::setBackend("+backend+")", "unknown backend");
+        _fftAux.reset(new FFTAux<std::complex<Type>>(_numBins, false, backend));
+    }
+
+    std::string getBackend(void) const
+    {
+        return _fftAux->backend();
+    }
+
+    //! always use a circular buffer so overlapping frames are contiguous
+    Pothos::BufferManager::Sptr getInputBufferManager(const std::string &, const std::string &)
+    {
+        return Pothos::BufferManager::make("circular");
+    }
+
+    //! Custom output buffer manager with slabs of a whole number of fft results
+    Pothos::BufferManager::Sptr getOutputBufferManager(const std::string &, const std::string &)
+    {
+        Pothos::BufferManagerArgs args;
+        args.bufferSize = std::max<size_t>(1, STFT_SLAB_ELEMENTS/_numBins)*_numBins*this->output(0)->dtype().size();
+        return Pothos::BufferManager::make("generic", args);
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        auto outPort = this->output(0);
+        const size_t frameSpan = std::max(_numBins, _hop);
+
+        //transform every frame that fits in the available input and output
+        const InType *in = inPort->buffer();
+        const size_t numIn = inPort->elements();
+        const size_t numOut = outPort->elements();
+        size_t consumed = 0, produced = 0;
+        while (consumed + frameSpan <= numIn and produced + _numBins <= numOut)
+        {
+            //stage the windowed frame for the transform
+            for (size_t n = 0; n < _numBins; n++)
+            {
+                _stage[n] = std::complex<Type>(in[consumed+n])*_window[n];
+            }
+
+            //transform directly into the output, real modes are converted in the final stores
+            if (_outputMode == FFT_OUTPUT_COMPLEX)
+            {
+                _fftAux->transform(_stage.data(), outPort->buffer().template as<std::complex<Type> *>()+produced);
+            }
+            else
+            {
+                _fftAux->transform(_stage.data(), outPort->buffer().template as<Type *>()+produced, _outputMode);
+            }
+
+            consumed += _hop;
+            produced += _numBins;
+        }
+
+        if (consumed != 0) inPort->consume(consumed);
+        if (produced != 0) outPort->produce(produced);
+    }
+
+private:
+    void recalculateWindow(void)
+    {
+        const auto window = design_window(_windowType, _numBins, _windowArgs.empty()?0.0:_windowArgs.at(0));
+        if (window.size() != _numBins) throw Pothos::InvalidArgumentException("STFT::setWindowType("+_windowType+")", "unknown window type");
+        _window.assign(window.begin(), window.end());
+    }
+
+    const size_t _numBins;
+    const FFTOutputMode _outputMode;
+    size_t _hop;
+    std::string _windowType;
+    std::vector<double> _windowArgs;
+    std::vector<Type> _window;
+    std::vector<std::complex<Type>> _stage;
+    std::unique_ptr<FFTAux<std::complex<Type>>> _fftAux;
+};
+
+/***********************************************************************
+ * registration
+ **********************************************************************/
+static Pothos::Block *STFTFactory(const Pothos::DType &dtype, const size_t numBins, const std::string &output)
+{
+    if (numBins == 0) throw Pothos::InvalidArgumentException("STFTFactory()", "num bins cannot be 0");
+
+    #define ifTypeDeclareFactory(Type) \
+        if (dtype == Pothos::DType(typeid(Type))) return new STFT<Type, Type>(numBins, output); \
+        if (dtype == Pothos::DType(typeid(std::complex<Type>))) return new STFT<std::complex<Type>, Type>(numBins, output);
+    ifTypeDeclareFactory(double);
+    ifTypeDeclareFactory(float);
+    throw Pothos::InvalidArgumentException("STFTFactory("+dtype.toString()+")", "unsupported type");
+}
+static Pothos::BlockRegistry registerSTFT(
+    "/comms/stft", &STFTFactory);
@@ -7,6 +7,9 @@
 #include <iostream>
 #include <vector>
 #include <complex>
+#include <string>
+#include <cstdlib> //rand
+#include <cmath>
 
 POTHOS_TEST_BLOCK("/comms/tests", test_fft_float)
 {
@@ -156,3 +159,279 @@ POTHOS_TEST_BLOCK("/comms/tests", test_fft_short)
         POTHOS_TEST_TRUE(std::abs(pb[i].imag()-input[i].imag()) < 0.01);
     }
 }
+
+POTHOS_TEST_BLOCK("/comms/tests", test_fft_real)
+{
+    /*
+    numpy.fft.rfft([0.4, -0.7, -0.2, 0.9])
+    array([ 0.4+0.j ,  0.6+1.6j,  0.0+0.j ])
+    */
+
+    std::vector<float> input;
+    input.push_back(0.4);
+    input.push_back(-0.7);
+    input.push_back(-0.2);
+    input.push_back(0.9);
+
+    std::vector<std::complex<float>> result;
+    result.emplace_back(0.4, 0.0);
+    result.emplace_back(0.6, 1.6);
+    result.emplace_back(0.0, 0.0);
+
+    //create blocks
+    const auto dtype = Pothos::DType(typeid(float));
+    const auto cdtype = Pothos::DType(typeid(std::complex<float>));
+    auto source = Pothos::BlockRegistry::make("/blocks/vector_source", dtype);
+    source.call("setElements", input);
+    source.call("setMode", "ONCE");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", cdtype);
+    auto fft = Pothos::BlockRegistry::make("/comms/fft", dtype, input.size(), false);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(source, 0, fft, 0);
+        topology.connect(fft, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check the buffer
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(buff.elements(), result.size());
+    auto pb = buff.as<const std::complex<float> *>();
+    for (size_t i = 0; i < buff.elements(); i++)
+    {
+        std::cout << i << " RFFT expected " << result[i] << " actual " << pb[i] << std::endl;
+        POTHOS_TEST_TRUE(std::abs(pb[i].real()-result[i].real()) < 0.01);
+        POTHOS_TEST_TRUE(std::abs(pb[i].imag()-result[i].imag()) < 0.01);
+    }
+
+    //perform the inverse real fft and check the result
+    auto cSource = Pothos::BlockRegistry::make("/blocks/vector_source", cdtype);
+    cSource.call("setElements", result);
+    cSource.call("setMode", "ONCE");
+    auto rCollector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+    auto ifft = Pothos::BlockRegistry::make("/comms/fft", dtype, input.size(), true);
+    {
+        Pothos::Topology topology;
+        topology.connect(cSource, 0, ifft, 0);
+        topology.connect(ifft, 0, rCollector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check the buffer
+    buff = rCollector.call<Pothos::BufferChunk>("getBuffer");
+    POTHOS_TEST_EQUAL(buff.elements(), input.size());
+    auto pr = buff.as<const float *>();
+    for (size_t i = 0; i < buff.elements(); i++)
+    {
+        std::cout << i << " IRFFT expected " << input[i] << " actual " << pr[i] << std::endl;
+        POTHOS_TEST_TRUE(std::abs(pr[i]-input[i]*input.size()) < 0.01);
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_fft_backends)
+{
+    //random input over a power-of-two size supported by all backends
+    const size_t numBins = 256;
+    std::vector<std::complex<float>> input;
+    for (size_t i = 0; i < numBins; i++)
+    {
+        input.emplace_back(std::rand()/float(RAND_MAX)-0.5f, std::rand()/float(RAND_MAX)-0.5f);
+    }
+
+    const auto dtype = Pothos::DType(typeid(std::complex<float>));
+    for (const bool inverse : {false, true})
+    {
+        std::vector<Pothos::BufferChunk> results;
+        for (const std::string backend : {"kissfft", "simd", "fourstep", "auto"})
+        {
+            auto source = Pothos::BlockRegistry::make("/blocks/vector_source", dtype);
+            source.call("setElements", input);
+            source.call("setMode", "ONCE");
+            auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+            auto fft = Pothos::BlockRegistry::make("/comms/fft", dtype, numBins, inverse);
+            fft.call("setBackend", backend);
+            fft.call("setNumThreads", 2);
+            std::cout << "backend " << backend << " -> " << fft.call<std::string>("getBackend") << std::endl;
+
+            {
+                Pothos::Topology topology;
+                topology.connect(source, 0, fft, 0);
+                topology.connect(fft, 0, collector, 0);
+                topology.commit();
+                POTHOS_TEST_TRUE(topology.waitInactive());
+            }
+
+            results.push_back(collector.call<Pothos::BufferChunk>("getBuffer"));
+            POTHOS_TEST_EQUAL(results.back().elements(), numBins);
+        }
+
+        //all backends should produce the same transform
+        const auto expected = results.front().as<const std::complex<float> *>();
+        for (const auto &result : results)
+        {
+            const auto actual = result.as<const std::complex<float> *>();
+            for (size_t i = 0; i < numBins; i++)
+            {
+                POTHOS_TEST_TRUE(std::abs(expected[i]-actual[i]) < 1e-3);
+            }
+        }
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_fft_block_float)
+{
+    //a small tone in a large transform, kissfft would scale it down to nothing
+    const size_t numBins = 1024;
+    const size_t toneBin = 37;
+    const double amplitude = 40.0;
+    std::vector<std::complex<float>> input;
+    for (size_t i = 0; i < numBins; i++)
+    {
+        input.push_back(std::complex<float>(std::polar(amplitude, 2*std::acos(-1.0)*toneBin*i/numBins)));
+    }
+
+    const auto dtype = Pothos::DType(typeid(std::complex<short>));
+    auto source = Pothos::BlockRegistry::make("/blocks/vector_source", dtype);
+    source.call("setElements", input);
+    source.call("setMode", "ONCE");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+    auto fft = Pothos::BlockRegistry::make("/comms/fft", dtype, numBins, false);
+    fft.call("setBackend", "bfp");
+    POTHOS_TEST_EQUAL(fft.call<std::string>("getBackend"), "bfp");
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(source, 0, fft, 0);
+        topology.connect(fft, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check the exponent label
+    std::vector<Pothos::Label> labels = collector.call("getLabels");
+    POTHOS_TEST_EQUAL(labels.size(), 1);
+    POTHOS_TEST_EQUAL(labels[0].id, "fftExp");
+    POTHOS_TEST_EQUAL(labels[0].index, 0);
+    const int exponent = labels[0].data.convert<int>();
+    std::cout << "block exponent " << exponent << std::endl;
+
+    //check the scaled result against the unscaled tone
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(buff.elements(), numBins);
+    auto pb = buff.as<const std::complex<short> *>();
+    const double scale = std::ldexp(1.0, exponent);
+    for (size_t i = 0; i < numBins; i++)
+    {
+        const double expected = (i == toneBin)?(amplitude*numBins):0.0;
+        const std::complex<double> actual(pb[i].real()*scale, pb[i].imag()*scale);
+        POTHOS_TEST_TRUE(std::abs(actual-expected) < 0.02*amplitude*numBins);
+    }
+    POTHOS_TEST_TRUE(std::abs(std::complex<double>(pb[toneBin].real(), pb[toneBin].imag())) > 1000);
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_fft_output_modes)
+{
+    //two tones of different power, checked against the shifted power spectrum
+    const size_t numBins = 64;
+    std::vector<std::complex<float>> input(numBins);
+    for (size_t i = 0; i < numBins; i++)
+    {
+        input[i] = std::complex<float>(std::polar(1.0, 2*std::acos(-1.0)*5*i/numBins));
+        input[i] += std::complex<float>(std::polar(0.5, -2*std::acos(-1.0)*9*i/numBins));
+    }
+    std::vector<double> power(numBins, 0.0);
+    power[(5+numBins/2)%numBins] = numBins*numBins;
+    power[(numBins-9+numBins/2)%numBins] = numBins*numBins/4.0;
+
+    const auto dtype = Pothos::DType(typeid(std::complex<float>));
+    for (const std::string backend : {"kissfft", "simd"})
+    {
+        for (const std::string mode : {"POWER", "DB"})
+        {
+            std::cout << "testing output mode " << mode << " with backend " << backend << std::endl;
+            auto source = Pothos::BlockRegistry::make("/blocks/vector_source", dtype);
+            source.call("setElements", input);
+            source.call("setMode", "ONCE");
+            auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "float32");
+            auto fft = Pothos::BlockRegistry::make("/comms/fft", dtype, numBins, false);
+            fft.call("setOutputMode", mode);
+            fft.call("setBackend", backend);
+            fft.call("setFFTShift", true);
+
+            //run the topology
+            {
+                Pothos::Topology topology;
+                topology.connect(source, 0, fft, 0);
+                topology.connect(fft, 0, collector, 0);
+                topology.commit();
+                POTHOS_TEST_TRUE(topology.waitInactive());
+            }
+
+            //check the real output against the expected spectrum
+            Pothos::BufferChunk buff = collector.call("getBuffer");
+            POTHOS_TEST_EQUAL(buff.elements(), numBins);
+            auto pb = buff.as<const float *>();
+            for (size_t i = 0; i < numBins; i++)
+            {
+                if (mode == "POWER") POTHOS_TEST_TRUE(std::abs(pb[i]-power[i]) < 0.01);
+                else if (power[i] != 0.0) POTHOS_TEST_TRUE(std::abs(pb[i]-10*std::log10(power[i])) < 0.01);
+                else POTHOS_TEST_TRUE(pb[i] < -50);
+            }
+        }
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_fft_multi_channel)
+{
+    //one tone per channel with a different bin and amplitude, interleaved by channel
+    const size_t numBins = 32;
+    const size_t numChannels = 4;
+    std::vector<std::complex<float>> input(numBins*numChannels);
+    for (size_t i = 0; i < numBins; i++)
+    {
+        for (size_t c = 0; c < numChannels; c++)
+        {
+            input[i*numChannels+c] = std::complex<float>(std::polar(1.0+c, 2*std::acos(-1.0)*(3+5*c)*i/numBins));
+        }
+    }
+
+    const auto dtype = Pothos::DType(typeid(std::complex<float>));
+    const auto vectorType = Pothos::DType(typeid(std::complex<float>), numChannels);
+    for (const std::string backend : {"kissfft", "simd"})
+    {
+        std::cout << "testing " << numChannels << " channels with backend " << backend << std::endl;
+        auto source = Pothos::BlockRegistry::make("/blocks/vector_source", dtype);
+        source.call("setElements", input);
+        source.call("setMode", "ONCE");
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+        auto fft = Pothos::BlockRegistry::make("/comms/fft", vectorType, numBins, false);
+        fft.call("setBackend", backend);
+
+        //run the topology
+        {
+            Pothos::Topology topology;
+            topology.connect(source, 0, fft, 0);
+            topology.connect(fft, 0, collector, 0);
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive());
+        }
+
+        //every output element holds the same bin of each channel
+        Pothos::BufferChunk buff = collector.call("getBuffer");
+        POTHOS_TEST_EQUAL(buff.elements(), numBins*numChannels);
+        auto pb = buff.as<const std::complex<float> *>();
+        for (size_t k = 0; k < numBins; k++)
+        {
+            for (size_t c = 0; c < numChannels; c++)
+            {
+                const float expected = (k == 3+5*c)?(1.0f+c)*numBins:0.0f;
+                POTHOS_TEST_TRUE(std::abs(std::abs(pb[k*numChannels+c])-expected) < 1e-3);
+            }
+        }
+    }
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <iostream>
+#include <vector>
+#include <complex>
+#include <cmath>
+
+POTHOS_TEST_BLOCK("/comms/tests", test_fast_correlator)
+{
+    //length 31 m-sequence reference from the LFSR x^5 + x^3 + 1
+    std::vector<std::complex<float>> reference;
+    unsigned lfsr = 0x1f;
+    for (size_t i = 0; i < 31; i++)
+    {
+        reference.push_back(std::complex<float>((lfsr & 1)?1.0f:-1.0f));
+        const unsigned bit = ((lfsr >> 0) ^ (lfsr >> 2)) & 1;
+        lfsr = (lfsr >> 1) | (bit << 4);
+    }
+
+    //two copies of the reference with different gains and phases
+    const size_t positions[] = {100, 300};
+    const std::complex<float> gains[] = {std::complex<float>(std::polar(2.0, 0.5)), std::complex<float>(std::polar(0.5, -2.0))};
+    std::vector<std::complex<float>> input(500);
+    for (size_t i = 0; i < 2; i++)
+    {
+        for (size_t m = 0; m < reference.size(); m++) input[positions[i]+m] += reference[m]*gains[i];
+    }
+
+    //create blocks
+    const auto dtype = Pothos::DType(typeid(std::complex<float>));
+    auto source = Pothos::BlockRegistry::make("/blocks/vector_source", dtype);
+    source.call("setElements", input);
+    source.call("setMode", "ONCE");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "float32");
+    auto correlator = Pothos::BlockRegistry::make("/comms/fast_correlator", dtype);
+    correlator.call("setReference", reference);
+    correlator.call("setThreshold", 0.4);
+    POTHOS_TEST_EQUAL(correlator.call<size_t>("getFFTSize"), 128);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(source, 0, correlator, 0);
+        topology.connect(correlator, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //the peak magnitudes are the gains of the matches
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_TRUE(buff.elements() > positions[1]);
+    auto pb = buff.as<const float *>();
+    for (size_t i = 0; i < 2; i++)
+    {
+        std::cout << "peak " << positions[i] << " magnitude " << pb[positions[i]] << std::endl;
+        POTHOS_TEST_TRUE(std::abs(pb[positions[i]]-std::abs(gains[i])) < 1e-3);
+    }
+
+    //one label per match with the complex gain
+    std::vector<Pothos::Label> labels = collector.call("getLabels");
+    POTHOS_TEST_EQUAL(labels.size(), 2);
+    for (size_t i = 0; i < 2; i++)
+    {
+        POTHOS_TEST_EQUAL(labels[i].id, "corrPeak");
+        POTHOS_TEST_EQUAL(labels[i].index, positions[i]);
+        const auto value = labels[i].data.convert<std::complex<float>>();
+        POTHOS_TEST_TRUE(std::abs(value-gains[i]) < 1e-3);
+    }
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <iostream>
+#include <vector>
+#include <complex>
+#include <string>
+#include <cmath>
+
+POTHOS_TEST_BLOCK("/comms/tests", test_goertzel_bank)
+{
+    const double rate = 8000.0;
+    const size_t frameLength = 64;
+    const size_t decimation = 16;
+    const size_t numOutputs = 8;
+
+    //a tone on an exact bin, the other frequencies are exact bins without energy
+    std::vector<double> freqs;
+    freqs.push_back(-2000.0);
+    freqs.push_back(1000.0);
+    freqs.push_back(1500.0);
+    std::vector<std::complex<float>> input;
+    for (size_t i = 0; i < frameLength + (numOutputs-1)*decimation; i++)
+    {
+        input.push_back(std::complex<float>(std::polar(0.5, 2*std::acos(-1.0)*1000.0*i/rate)));
+    }
+
+    const auto dtype = Pothos::DType(typeid(std::complex<float>));
+    for (const std::string mode : {"BLOCK", "SLIDING"})
+    {
+        std::cout << "testing goertzel bank mode " << mode << std::endl;
+        auto source = Pothos::BlockRegistry::make("/blocks/vector_source", dtype);
+        source.call("setElements", input);
+        source.call("setMode", "ONCE");
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "float32");
+        auto bank = Pothos::BlockRegistry::make("/comms/goertzel_bank", dtype, "POWER");
+        bank.call("setMode", mode);
+        bank.call("setSampleRate", rate);
+        bank.call("setFrequencies", freqs);
+        bank.call("setFrameLength", frameLength);
+        bank.call("setDecimation", decimation);
+
+        //run the topology
+        {
+            Pothos::Topology topology;
+            topology.connect(source, 0, bank, 0);
+            topology.connect(bank, 0, collector, 0);
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive());
+        }
+
+        //every frame has the full tone power in the tone bin only
+        Pothos::BufferChunk buff = collector.call("getBuffer");
+        POTHOS_TEST_EQUAL(buff.elements(), numOutputs*freqs.size());
+        auto pb = buff.as<const float *>();
+        const double tonePower = std::pow(0.5*frameLength, 2);
+        for (size_t i = 0; i < buff.elements(); i++)
+        {
+            const double expected = ((i % freqs.size()) == 1)?tonePower:0.0;
+            POTHOS_TEST_TRUE(std::abs(pb[i]-expected) < 1e-3*tonePower);
+        }
+    }
+}
@@ -0,0 +1,202 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <iostream>
+#include <vector>
+#include <complex>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+POTHOS_TEST_BLOCK("/comms/tests", test_ofdm_loopback)
+{
+    const size_t fftSize = 64;
+    const size_t cpLength = 16;
+    const size_t numSymbols = 10;
+
+    //802.11 style subcarriers: 48 data carriers, 4 pilots, and unused guard carriers
+    const std::vector<int> pilotCarriers = {-21, -7, 7, 21};
+    std::vector<int> dataCarriers;
+    for (int k = -26; k <= 26; k++)
+    {
+        if (k == 0 or k == -21 or k == -7 or k == 7 or k == 21) continue;
+        dataCarriers.push_back(k);
+    }
+    const std::vector<std::complex<float>> pilotValues = {
+        std::complex<float>(1.0f), std::complex<float>(1.0f),
+        std::complex<float>(1.0f), std::complex<float>(-1.0f)};
+
+    //random QPSK data symbols
+    std::vector<std::complex<float>> input;
+    for (size_t i = 0; i < numSymbols*dataCarriers.size(); i++)
+    {
+        input.push_back(std::complex<float>((std::rand() & 1)?1.0f:-1.0f, (std::rand() & 1)?1.0f:-1.0f));
+    }
+
+    //create blocks
+    const auto dtype = Pothos::DType(typeid(std::complex<float>));
+    auto source = Pothos::BlockRegistry::make("/blocks/vector_source", dtype);
+    source.call("setElements", input);
+    source.call("setMode", "ONCE");
+    auto mod = Pothos::BlockRegistry::make("/comms/ofdm_mod", dtype, fftSize);
+    mod.call("setCyclicPrefix", cpLength);
+    mod.call("setDataCarriers", dataCarriers);
+    mod.call("setPilotCarriers", pilotCarriers);
+    mod.call("setPilotValues", pilotValues);
+    auto demod = Pothos::BlockRegistry::make("/comms/ofdm_demod", dtype, fftSize);
+    demod.call("setCyclicPrefix", cpLength);
+    demod.call("setDataCarriers", dataCarriers);
+    demod.call("setPilotCarriers", pilotCarriers);
+    auto modCollector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+    auto dataCollector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+    auto pilotCollector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(source, 0, mod, 0);
+        topology.connect(mod, 0, modCollector, 0);
+        topology.connect(mod, 0, demod, 0);
+        topology.connect(demod, 0, dataCollector, 0);
+        topology.connect(demod, 1, pilotCollector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //the modulator output has a cyclic prefix and a label per OFDM symbol
+    Pothos::BufferChunk modBuff = modCollector.call("getBuffer");
+    POTHOS_TEST_EQUAL(modBuff.elements(), numSymbols*(fftSize+cpLength));
+    auto pm = modBuff.as<const std::complex<float> *>();
+    for (size_t s = 0; s < numSymbols; s++)
+    {
+        const auto symbol = pm + s*(fftSize+cpLength);
+        for (size_t i = 0; i < cpLength; i++) POTHOS_TEST_TRUE(std::abs(symbol[i]-symbol[i+fftSize]) < 1e-6);
+    }
+    std::vector<Pothos::Label> modLabels = modCollector.call("getLabels");
+    POTHOS_TEST_EQUAL(modLabels.size(), numSymbols);
+    for (size_t s = 0; s < numSymbols; s++)
+    {
+        POTHOS_TEST_EQUAL(modLabels[s].id, "symStart");
+        POTHOS_TEST_EQUAL(modLabels[s].index, s*(fftSize+cpLength));
+    }
+
+    //the demodulator recovers the data symbols
+    Pothos::BufferChunk dataBuff = dataCollector.call("getBuffer");
+    POTHOS_TEST_EQUAL(dataBuff.elements(), input.size());
+    auto pd = dataBuff.as<const std::complex<float> *>();
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        POTHOS_TEST_TRUE(std::abs(pd[i]-input[i]) < 1e-4);
+    }
+    std::vector<Pothos::Label> dataLabels = dataCollector.call("getLabels");
+    POTHOS_TEST_EQUAL(dataLabels.size(), numSymbols);
+    for (size_t s = 0; s < numSymbols; s++)
+    {
+        POTHOS_TEST_EQUAL(dataLabels[s].id, "symStart");
+        POTHOS_TEST_EQUAL(dataLabels[s].index, s*dataCarriers.size());
+    }
+
+    //and the pilots of every OFDM symbol
+    Pothos::BufferChunk pilotBuff = pilotCollector.call("getBuffer");
+    POTHOS_TEST_EQUAL(pilotBuff.elements(), numSymbols*pilotCarriers.size());
+    auto pp = pilotBuff.as<const std::complex<float> *>();
+    for (size_t i = 0; i < pilotBuff.elements(); i++)
+    {
+        POTHOS_TEST_TRUE(std::abs(pp[i]-pilotValues[i % pilotValues.size()]) < 1e-4);
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_ofdm_demod_realign_labels)
+{
+    const size_t fftSize = 64;
+    const size_t cpLength = 16;
+    const size_t symbolLength = fftSize+cpLength;
+    const size_t numSymbols = 40;
+    const size_t numData = fftSize-1; //every carrier except DC
+
+    std::vector<std::complex<float>> input;
+    for (size_t i = 0; i < numSymbols*numData; i++)
+    {
+        input.push_back(std::complex<float>((std::rand() & 1)?1.0f:-1.0f, (std::rand() & 1)?1.0f:-1.0f));
+    }
+
+    //modulate the data symbols
+    const auto dtype = Pothos::DType(typeid(std::complex<float>));
+    auto source = Pothos::BlockRegistry::make("/blocks/vector_source", dtype);
+    source.call("setElements", input);
+    source.call("setMode", "ONCE");
+    auto mod = Pothos::BlockRegistry::make("/comms/ofdm_mod", dtype, fftSize);
+    mod.call("setCyclicPrefix", cpLength);
+    auto modCollector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+    {
+        Pothos::Topology topology;
+        topology.connect(source, 0, mod, 0);
+        topology.connect(mod, 0, modCollector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+    Pothos::BufferChunk modBuff = modCollector.call("getBuffer");
+    POTHOS_TEST_EQUAL(modBuff.elements(), numSymbols*symbolLength);
+    auto pm = modBuff.as<const std::complex<float> *>();
+
+    //insert junk samples in front of some symbols, the symbol start labels realign the demodulator,
+    //and mark labels in the middle of symbols and inside the junk move to the data of their symbol
+    std::vector<size_t> junkLength(numSymbols, 0);
+    junkLength[5] = 23;
+    junkLength[17] = 41;
+    junkLength[18] = 7;
+    junkLength[33] = symbolLength-1;
+    const std::vector<size_t> markSymbols = {1, 5, 17, 20, 33, 39};
+    Pothos::BufferChunk rxBuff(dtype, numSymbols*symbolLength+23+41+7+symbolLength-1);
+    auto prx = rxBuff.as<std::complex<float> *>();
+    std::vector<Pothos::Label> labels;
+    std::vector<size_t> expectedMarks;
+    size_t index = 0;
+    for (size_t s = 0; s < numSymbols; s++)
+    {
+        const bool marked = std::find(markSymbols.begin(), markSymbols.end(), s) != markSymbols.end();
+        if (marked and junkLength[s] != 0) labels.emplace_back("mark", s, index+junkLength[s]/2);
+        if (marked and junkLength[s] != 0) expectedMarks.push_back(s*numData);
+        for (size_t i = 0; i < junkLength[s]; i++) prx[index++] = std::complex<float>(0.5f, -0.5f);
+        labels.emplace_back("symStart", s, index);
+        if (marked) labels.emplace_back("mark", s, index+cpLength+fftSize/2);
+        if (marked) expectedMarks.push_back(s*numData);
+        for (size_t i = 0; i < symbolLength; i++) prx[index++] = pm[s*symbolLength+i];
+    }
+    POTHOS_TEST_EQUAL(index, rxBuff.elements());
+
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+    feeder.call("feedLabels", labels);
+    feeder.call("feedBuffer", rxBuff);
+    auto demod = Pothos::BlockRegistry::make("/comms/ofdm_demod", dtype, fftSize);
+    demod.call("setCyclicPrefix", cpLength);
+    auto dataCollector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, demod, 0);
+        topology.connect(demod, 0, dataCollector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //the demodulator recovers every data symbol across the junk
+    Pothos::BufferChunk dataBuff = dataCollector.call("getBuffer");
+    POTHOS_TEST_EQUAL(dataBuff.elements(), input.size());
+    auto pd = dataBuff.as<const std::complex<float> *>();
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        POTHOS_TEST_TRUE(std::abs(pd[i]-input[i]) < 1e-4);
+    }
+
+    //and the mark labels are at the first data symbol of their OFDM symbol
+    std::vector<size_t> marks;
+    std::vector<Pothos::Label> dataLabels = dataCollector.call("getLabels");
+    for (const auto &label : dataLabels)
+    {
+        if (label.id == "mark") marks.push_back(label.index);
+    }
+    POTHOS_TEST_EQUAL(marks.size(), expectedMarks.size());
+    for (size_t i = 0; i < marks.size(); i++) POTHOS_TEST_EQUAL(marks[i], expectedMarks[i]);
+}
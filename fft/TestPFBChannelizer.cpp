@@ -0,0 +1,64 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <iostream>
+#include <vector>
+#include <complex>
+#include <cmath>
+
+POTHOS_TEST_BLOCK("/comms/tests", test_pfb_channelizer)
+{
+    const size_t numChannels = 4;
+    const size_t tapsPerChannel = 16;
+    const size_t numOutputs = 32;
+
+    //a unit tone at the center of channel 1
+    std::vector<std::complex<float>> input;
+    for (size_t i = 0; i < numChannels*(tapsPerChannel+numOutputs-1); i++)
+    {
+        input.push_back(std::complex<float>(std::polar(1.0, 2*std::acos(-1.0)*i/numChannels)));
+    }
+
+    //create blocks
+    const auto dtype = Pothos::DType(typeid(std::complex<float>));
+    auto source = Pothos::BlockRegistry::make("/blocks/vector_source", dtype);
+    source.call("setElements", input);
+    source.call("setMode", "ONCE");
+    auto channelizer = Pothos::BlockRegistry::make("/comms/pfb_channelizer", dtype, numChannels, "PORTS");
+    channelizer.call("setMode", "CRITICAL");
+    channelizer.call("setTapsPerChannel", tapsPerChannel);
+    channelizer.call("setWindowType", "blackman");
+    std::vector<Pothos::Proxy> collectors;
+    for (size_t k = 0; k < numChannels; k++)
+    {
+        collectors.push_back(Pothos::BlockRegistry::make("/blocks/collector_sink", dtype));
+    }
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(source, 0, channelizer, 0);
+        for (size_t k = 0; k < numChannels; k++)
+        {
+            topology.connect(channelizer, k, collectors[k], 0);
+        }
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //the tone channel is the DC gain of the prototype, the others are in the stop band
+    for (size_t k = 0; k < numChannels; k++)
+    {
+        Pothos::BufferChunk buff = collectors[k].call("getBuffer");
+        POTHOS_TEST_EQUAL(buff.elements(), numOutputs);
+        auto pb = buff.as<const std::complex<float> *>();
+        const std::complex<float> expected((k == 1)?1.0f:0.0f);
+        std::cout << "channel " << k << " expected " << expected << " actual " << pb[0] << std::endl;
+        for (size_t i = 0; i < buff.elements(); i++)
+        {
+            POTHOS_TEST_TRUE(std::abs(pb[i]-expected) < 1e-3);
+        }
+    }
+}
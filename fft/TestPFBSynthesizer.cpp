@@ -0,0 +1,124 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <iostream>
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <algorithm>
+
+POTHOS_TEST_BLOCK("/comms/tests", test_pfb_synthesizer)
+{
+    const size_t numChannels = 8;
+    const size_t activeChannel = 3;
+    const size_t numInputs = 200;
+
+    //a constant in one channel, every other synthesizer input is idle
+    std::vector<std::complex<float>> input(numInputs, std::complex<float>(1.0f));
+
+    //create blocks
+    const auto dtype = Pothos::DType(typeid(std::complex<float>));
+    auto source = Pothos::BlockRegistry::make("/blocks/vector_source", dtype);
+    source.call("setElements", input);
+    source.call("setMode", "ONCE");
+    auto synthesizer = Pothos::BlockRegistry::make("/comms/pfb_synthesizer", dtype, numChannels, "PORTS");
+    auto channelizer = Pothos::BlockRegistry::make("/comms/pfb_channelizer", dtype, numChannels, "PORTS");
+    std::vector<Pothos::Proxy> collectors;
+    for (size_t k = 0; k < numChannels; k++)
+    {
+        collectors.push_back(Pothos::BlockRegistry::make("/blocks/collector_sink", dtype));
+    }
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(source, 0, synthesizer, activeChannel);
+        topology.connect(synthesizer, 0, channelizer, 0);
+        for (size_t k = 0; k < numChannels; k++)
+        {
+            topology.connect(channelizer, k, collectors[k], 0);
+        }
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //the channelizer recovers the constant in the same channel after the filter transients
+    for (size_t k = 0; k < numChannels; k++)
+    {
+        Pothos::BufferChunk buff = collectors[k].call("getBuffer");
+        POTHOS_TEST_TRUE(buff.elements() > 150);
+        auto pb = buff.as<const std::complex<float> *>();
+        const float expected = (k == activeChannel)?1.0f:0.0f;
+        std::cout << "channel " << k << " expected " << expected << " actual " << std::abs(pb[100]) << std::endl;
+        for (size_t i = 32; i < 150; i++)
+        {
+            POTHOS_TEST_TRUE(std::abs(std::abs(pb[i])-expected) < 1e-3);
+        }
+    }
+}
+
+POTHOS_TEST_BLOCK("/comms/tests", test_pfb_synthesizer_late_channel)
+{
+    const size_t numChannels = 8;
+    const size_t numInputs = 4096;
+    const size_t pieceSize = 37;
+
+    //different tones in two channels
+    std::vector<std::complex<float>> input0(numInputs), input1(numInputs);
+    for (size_t i = 0; i < numInputs; i++)
+    {
+        input0[i] = std::polar(1.0f, 0.01f*i);
+        input1[i] = std::polar(0.5f, -0.03f*i);
+    }
+
+    //run once with both channels on time, and once with the second channel late in small pieces
+    const auto dtype = Pothos::DType(typeid(std::complex<float>));
+    std::vector<Pothos::BufferChunk> outputs;
+    for (const bool late : {false, true})
+    {
+        auto feeder0 = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+        auto feeder1 = Pothos::BlockRegistry::make("/blocks/feeder_source", dtype);
+        auto synthesizer = Pothos::BlockRegistry::make("/comms/pfb_synthesizer", dtype, numChannels, "PORTS");
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", dtype);
+
+        Pothos::BufferChunk b0(dtype, numInputs);
+        std::copy(input0.begin(), input0.end(), b0.as<std::complex<float> *>());
+        feeder0.call("feedBuffer", b0);
+        for (size_t i = 0; i < numInputs; i += (late?pieceSize:numInputs))
+        {
+            const size_t n = std::min(numInputs-i, late?pieceSize:numInputs);
+            Pothos::BufferChunk b1(dtype, n);
+            std::copy(input1.begin()+i, input1.begin()+i+n, b1.as<std::complex<float> *>());
+            feeder1.call("feedBuffer", b1);
+        }
+
+        //the throttle delivers the late channel over a longer time than the on time channel
+        auto delay = Pothos::BlockRegistry::make("/blocks/copier");
+        if (late)
+        {
+            delay = Pothos::BlockRegistry::make("/blocks/throttle");
+            delay.call("setRate", 100e3);
+        }
+
+        Pothos::Topology topology;
+        topology.connect(feeder0, 0, synthesizer, 1);
+        topology.connect(feeder1, 0, delay, 0);
+        topology.connect(delay, 0, synthesizer, 6);
+        topology.connect(synthesizer, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive(0.2, 5.0));
+        outputs.push_back(collector.call("getBuffer"));
+    }
+
+    //the late channel stays aligned, so the outputs are identical
+    POTHOS_TEST_EQUAL(outputs[0].elements(), numInputs*numChannels);
+    POTHOS_TEST_EQUAL(outputs[1].elements(), numInputs*numChannels);
+    auto p0 = outputs[0].as<const std::complex<float> *>();
+    auto p1 = outputs[1].as<const std::complex<float> *>();
+    for (size_t i = 0; i < outputs[0].elements(); i++)
+    {
+        POTHOS_TEST_TRUE(std::abs(p0[i]-p1[i]) < 1e-6);
+    }
+}
@@ -0,0 +1,56 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <iostream>
+#include <vector>
+#include <complex>
+#include <cmath>
+
+POTHOS_TEST_BLOCK("/comms/tests", test_psd_welch)
+{
+    const size_t numBins = 16;
+    const size_t hop = 8;
+    const size_t numAverages = 4;
+    const size_t toneBin = 3;
+
+    //exactly enough input for one averaged output
+    std::vector<std::complex<float>> input;
+    for (size_t i = 0; i < (numAverages-1)*hop + numBins; i++)
+    {
+        input.push_back(std::complex<float>(std::polar(1.0, 2*std::acos(-1.0)*toneBin*i/numBins)));
+    }
+
+    //create blocks
+    const auto dtype = Pothos::DType(typeid(std::complex<float>));
+    auto source = Pothos::BlockRegistry::make("/blocks/vector_source", dtype);
+    source.call("setElements", input);
+    source.call("setMode", "ONCE");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "float32");
+    auto psd = Pothos::BlockRegistry::make("/comms/psd", dtype, numBins);
+    psd.call("setHopSize", hop);
+    psd.call("setNumAverages", numAverages);
+    psd.call("setOutputMode", "POWER");
+    psd.call("setWindowType", "rectangular");
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(source, 0, psd, 0);
+        topology.connect(psd, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //a unit tone has power numBins in its bin after window normalization
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(buff.elements(), numBins);
+    auto pb = buff.as<const float *>();
+    for (size_t k = 0; k < numBins; k++)
+    {
+        const float expected = (k == toneBin)?float(numBins):0.0f;
+        std::cout << k << " PSD expected " << expected << " actual " << pb[k] << std::endl;
+        POTHOS_TEST_TRUE(std::abs(pb[k]-expected) < 1e-3);
+    }
+}
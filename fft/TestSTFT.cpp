@@ -0,0 +1,60 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <iostream>
+#include <vector>
+#include <complex>
+#include <cmath>
+
+POTHOS_TEST_BLOCK("/comms/tests", test_stft_overlap)
+{
+    const size_t numBins = 8;
+    const size_t hop = 3;
+    const size_t numFrames = 5;
+
+    std::vector<std::complex<float>> input;
+    for (size_t i = 0; i < (numFrames-1)*hop + numBins; i++)
+    {
+        input.emplace_back(std::cos(0.3f*i), std::sin(0.7f*i));
+    }
+
+    //create blocks
+    const auto dtype = Pothos::DType(typeid(std::complex<float>));
+    auto source = Pothos::BlockRegistry::make("/blocks/vector_source", dtype);
+    source.call("setElements", input);
+    source.call("setMode", "ONCE");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "float32");
+    auto stft = Pothos::BlockRegistry::make("/comms/stft", dtype, numBins, "MAGNITUDE");
+    stft.call("setHopSize", hop);
+    stft.call("setWindowType", "rectangular");
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(source, 0, stft, 0);
+        topology.connect(stft, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check each overlapping frame against a direct DFT
+    Pothos::BufferChunk buff = collector.call("getBuffer");
+    POTHOS_TEST_EQUAL(buff.elements(), numFrames*numBins);
+    auto pb = buff.as<const float *>();
+    for (size_t f = 0; f < numFrames; f++)
+    {
+        for (size_t k = 0; k < numBins; k++)
+        {
+            std::complex<double> sum(0.0);
+            for (size_t n = 0; n < numBins; n++)
+            {
+                sum += std::complex<double>(input[f*hop+n])*std::polar(1.0, -2*std::acos(-1.0)*k*n/numBins);
+            }
+            const auto actual = pb[f*numBins+k];
+            std::cout << f << ":" << k << " STFT expected " << std::abs(sum) << " actual " << actual << std::endl;
+            POTHOS_TEST_TRUE(std::abs(actual-std::abs(sum)) < 1e-3);
+        }
+    }
+}